@@ -0,0 +1,84 @@
+// LD_PRELOAD shim counting heap allocations of a benchmarked tool. The totals
+// are written as "ALLOCS BYTES" to the fd named by BENCH_ALLOC_FD at exit.
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+extern void* __libc_malloc(size_t);
+extern void* __libc_calloc(size_t, size_t);
+extern void* __libc_realloc(void*, size_t);
+extern void* __libc_memalign(size_t, size_t);
+
+static atomic_llong allocs;
+static atomic_llong bytes;
+
+static void count(
+    size_t size
+) {
+    atomic_fetch_add_explicit(&allocs, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&bytes, (long long)size, memory_order_relaxed);
+}
+
+void* malloc(
+    size_t size
+) {
+    count(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(
+    size_t n,
+    size_t size
+) {
+    count(n * size);
+    return __libc_calloc(n, size);
+}
+
+void* realloc(
+    void* ptr,
+    size_t size
+) {
+    count(size);
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(
+    size_t alignment,
+    size_t size
+) {
+    count(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(
+    size_t alignment,
+    size_t size
+) {
+    count(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(
+    void** ptr,
+    size_t alignment,
+    size_t size
+) {
+    count(size);
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr == NULL ? ENOMEM : 0;
+}
+
+__attribute__((destructor))
+static void report(void) {
+    const char* fd_str = getenv("BENCH_ALLOC_FD");
+    if (fd_str == NULL) return;
+
+    char buf[64];
+    int len = snprintf(buf, sizeof(buf), "%lld %lld\n", atomic_load(&allocs), atomic_load(&bytes));
+    ssize_t ret = write(atoi(fd_str), buf, (size_t)len);
+    (void)ret;
+}
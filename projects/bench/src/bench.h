@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/types.h>
+#include <string.h>
+
+#include "core.h"
+
+#define BENCH_MAX_CASES 64
+#define BENCH_MAX_PARALLEL 64
+#define BENCH_NAME_MAX 96
+#define BENCH_WRITE_FILES 256
+#define BENCH_SEED 0x9e3779b97f4a7c15ULL
+#define BENCH_NEEDLE "needle"
+#define BENCH_TARGET "target.txt"
+#define BENCH_NOISE_FLOOR_MS 1.0
+
+// a generated fixture tree under the bench tmpdir
+struct bench_fixture {
+    const char* name;
+    char root[CORE_PATH_MAX];
+    char list_dir[CORE_PATH_MAX];
+    uint64_t files;
+    uint64_t bytes;
+};
+
+// one measured command; parallel cases run `processes` instances at once
+struct bench_case {
+    char name[BENCH_NAME_MAX];
+    int processes;
+    char** argv[BENCH_MAX_PARALLEL];
+    // emptied before every run of the matching process; NULL when it writes nothing
+    char* fresh_dir[BENCH_MAX_PARALLEL];
+};
+
+// counters are -1 when they could not be collected
+struct bench_result {
+    char name[BENCH_NAME_MAX];
+    double wall_ms_min;
+    double wall_ms_median;
+    int64_t syscalls;
+    int64_t allocs;
+    int64_t alloc_bytes;
+    int64_t max_rss_kb;
+    int exit_status;
+};
+
+struct bench_options {
+    int repeat;
+    int jobs;
+    int scale;
+    int verbose;
+    const char* filter;
+};
+
+int bench_fixture_build(struct bench_fixture*, const char*, const char*, int);
+
+int bench_remove_tree(const char*);
+
+int bench_run_case(const struct bench_options*, const struct bench_case*, struct bench_result*);
+
+int bench_report_write(struct core_out*, const struct bench_options*, const struct bench_fixture*, size_t, const struct bench_result*, size_t);
+
+int bench_report_read(const char*, struct bench_result**, size_t*, int*);
+
+int bench_report_compare(const struct bench_options*, const struct bench_result*, size_t, const struct bench_result*, size_t, double);
+
+int main(int, char**);
@@ -0,0 +1,218 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <ftw.h>
+#include <sys/stat.h>
+
+#include "bench.h"
+
+static const char* words[] = {
+    "alpha", "beta", "gamma", "delta", "request", "response", "error", "info",
+    "value", "id", "user", "session", "timeout", "retry", "cache", "index",
+};
+
+// xorshift64*: fixed seed, so every run builds byte-identical trees
+static uint64_t next_random(
+    uint64_t* state
+) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545f4914f6cdd1dULL;
+}
+
+static void write_text(
+    struct core_out* out,
+    uint64_t* rng,
+    uint64_t bytes
+) {
+    uint64_t written = 0;
+    int words_in_line = 0;
+
+    while (written < bytes) {
+        uint64_t r = next_random(rng);
+        const char* word = (r & 63) == 0 ? BENCH_NEEDLE : words[(r >> 8) % (sizeof(words) / sizeof(words[0]))];
+        size_t len = strlen(word);
+
+        core_out_write(out, word, len);
+        written += len + 1;
+        if (++words_in_line == 10 || written >= bytes) {
+            core_out_char(out, '\n');
+            words_in_line = 0;
+        } else {
+            core_out_char(out, ' ');
+        }
+    }
+}
+
+static int write_fixture_file(
+    struct bench_fixture* fixture,
+    uint64_t* rng,
+    const char* dir,
+    const char* name,
+    uint64_t bytes
+) {
+    char path[CORE_PATH_MAX];
+    struct core_out* out = malloc(sizeof(*out));
+    if (out == NULL) return core_error(ERROR_MALLOC, "malloc failed");
+
+    int status = core_path_join(path, sizeof(path), dir, name);
+    if (status == 0) status = core_out_open(out, path, 0);
+    if (status == 0) {
+        write_text(out, rng, bytes);
+        if (core_out_close(out) != 0) status = core_error(ERROR_FWRITE, "failed to write %s", path);
+    }
+    free(out);
+
+    fixture->files++;
+    fixture->bytes += bytes;
+    return status;
+}
+
+static int make_dir(
+    const char* path
+) {
+    if (mkdir(path, 0755) == -1 && errno != EEXIST) {
+        return core_error(ERROR_DIR_OPEN, "unable to create directory %s: %s", path, strerror(errno));
+    }
+    return 0;
+}
+
+// one long chain of nested directories with a few files per level
+static int build_deep(
+    struct bench_fixture* fixture,
+    int scale,
+    uint64_t* rng
+) {
+    char path[CORE_PATH_MAX];
+    char next[CORE_PATH_MAX];
+    int depth = 48 * scale > 400 ? 400 : 48 * scale;
+
+    strcpy(path, fixture->root);
+    for (int level = 0; level < depth; level++) {
+        for (int i = 0; i < 4; i++) {
+            char name[32];
+            snprintf(name, sizeof(name), "file%d.txt", i);
+            if (write_fixture_file(fixture, rng, path, name, 2048) != 0) return core_last_error();
+        }
+        if (core_path_join(next, sizeof(next), path, "d") != 0 || make_dir(next) != 0) return core_last_error();
+        strcpy(path, next);
+    }
+
+    strcpy(fixture->list_dir, fixture->root);
+    return write_fixture_file(fixture, rng, path, BENCH_TARGET, 2048);
+}
+
+// a single directory with thousands of entries
+static int build_wide(
+    struct bench_fixture* fixture,
+    int scale,
+    uint64_t* rng
+) {
+    int files = 4000 * scale;
+
+    for (int i = 0; i < files; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "file%05d.txt", i);
+        if (write_fixture_file(fixture, rng, fixture->root, name, 512) != 0) return core_last_error();
+    }
+
+    strcpy(fixture->list_dir, fixture->root);
+    return write_fixture_file(fixture, rng, fixture->root, BENCH_TARGET, 512);
+}
+
+// many directories of small source-like files
+static int build_many_small(
+    struct bench_fixture* fixture,
+    int scale,
+    uint64_t* rng
+) {
+    char path[CORE_PATH_MAX];
+    int dirs = 32 * scale;
+
+    for (int d = 0; d < dirs; d++) {
+        char name[32];
+        snprintf(name, sizeof(name), "dir%03d", d);
+        if (core_path_join(path, sizeof(path), fixture->root, name) != 0 || make_dir(path) != 0) return core_last_error();
+
+        for (int i = 0; i < 128; i++) {
+            snprintf(name, sizeof(name), "file%03d.txt", i);
+            uint64_t bytes = 1024 + next_random(rng) % 3072;
+            if (write_fixture_file(fixture, rng, path, name, bytes) != 0) return core_last_error();
+        }
+        if (d % 8 == 0 && write_fixture_file(fixture, rng, path, BENCH_TARGET, 1024) != 0) return core_last_error();
+    }
+
+    return core_path_join(fixture->list_dir, sizeof(fixture->list_dir), fixture->root, "dir000");
+}
+
+// a handful of large files, where scanning throughput dominates
+static int build_few_huge(
+    struct bench_fixture* fixture,
+    int scale,
+    uint64_t* rng
+) {
+    uint64_t bytes = (uint64_t)scale * 16 * 1024 * 1024;
+
+    for (int i = 0; i < 3; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "huge%d.txt", i);
+        if (write_fixture_file(fixture, rng, fixture->root, name, bytes) != 0) return core_last_error();
+    }
+
+    strcpy(fixture->list_dir, fixture->root);
+    return write_fixture_file(fixture, rng, fixture->root, BENCH_TARGET, bytes);
+}
+
+static const struct {
+    const char* name;
+    int (*build)(struct bench_fixture*, int, uint64_t*);
+} builders[] = {
+    { "deep",       build_deep       },
+    { "wide",       build_wide       },
+    { "many-small", build_many_small },
+    { "few-huge",   build_few_huge   },
+};
+
+int bench_fixture_build(
+    struct bench_fixture* fixture,
+    const char* base,
+    const char* name,
+    int scale
+) {
+    for (size_t i = 0; i < sizeof(builders) / sizeof(builders[0]); i++) {
+        if (strcmp(builders[i].name, name) != 0) continue;
+
+        uint64_t rng = BENCH_SEED ^ (uint64_t)(i + 1);
+        fixture->name = builders[i].name;
+        fixture->files = 0;
+        fixture->bytes = 0;
+        if (core_path_join(fixture->root, sizeof(fixture->root), base, name) != 0) return ERROR_PATH_TOO_LONG;
+        if (make_dir(fixture->root) != 0) return ERROR_DIR_OPEN;
+
+        return builders[i].build(fixture, scale, &rng);
+    }
+
+    return core_error(ERROR_INVALID_OPTION, "unknown fixture %s", name);
+}
+
+static int remove_entry(
+    const char* path,
+    const struct stat* st,
+    int type,
+    struct FTW* ftw
+) {
+    (void)st;
+    (void)type;
+    (void)ftw;
+    return remove(path) == -1 ? -1 : 0;
+}
+
+int bench_remove_tree(
+    const char* path
+) {
+    if (nftw(path, remove_entry, 64, FTW_DEPTH | FTW_PHYS) == -1) {
+        return core_error(ERROR_GENERIC, "unable to remove %s: %s", path, strerror(errno));
+    }
+    return 0;
+}
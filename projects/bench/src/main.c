@@ -0,0 +1,393 @@
+#define _GNU_SOURCE
+
+#include "bench.h"
+
+#define ARENA_SIZE (4 * 1024 * 1024)
+
+static const struct core_tool tool = {
+    .name = "bench",
+    .version = CORE_VERSION,
+    .usage =
+        "usage: bench [OPTION]...\n"
+        "\nBuild reproducible fixture trees (deep, wide, many-small, few-huge) in a temporary\n"
+        "directory, run every tool's hot path on them in a fixed and a parallel configuration,\n"
+        "and report wall time, syscalls, allocations and peak RSS as JSON\n"
+        "\nOptions:\n"
+        "    -o FILE, --output FILE       : write the JSON report to FILE (default: stdout, unless\n"
+        "                                   comparing against a baseline)\n"
+        "    -b FILE, --baseline FILE     : compare against a saved report and exit non-zero if any\n"
+        "                                   case's median wall time regressed past the threshold,\n"
+        "                                   or a baseline case the filter didn't exclude is missing\n"
+        "    -t PCT, --threshold PCT      : regression threshold in percent (default 10)\n"
+        "    -r N, --repeat N             : timed runs per case (default 5)\n"
+        "    -j N, --jobs N               : width of the parallel configuration (default: online\n"
+        "                                   CPUs, at least 2)\n"
+        "    -s N, --scale N              : fixture size multiplier (default 1)\n"
+        "    -f TEXT, --filter TEXT       : only run cases whose name contains TEXT\n"
+        "    -k, --keep                   : keep the fixture directory after running\n"
+        "    -v, --verbose                : print progress to stderr\n"
+        "    -h, --help                   : show this message and exit\n"
+        "    -V, --version                : show the program version and exit\n"
+        "\nCase names are TOOL/FIXTURE/CONFIG, e.g. search/few-huge/parallel.\n",
+};
+
+static const char* fixture_names[] = { "deep", "wide", "many-small", "few-huge" };
+
+// argv arrays and strings for every case live here and are freed together
+struct arena {
+    char* data;
+    size_t len;
+    size_t cap;
+};
+
+static void* arena_alloc(
+    struct arena* arena,
+    size_t size
+) {
+    size = (size + 15) & ~(size_t)15;
+    if (arena->len + size > arena->cap) return NULL;
+
+    void* ptr = arena->data + arena->len;
+    arena->len += size;
+    return ptr;
+}
+
+static char* arena_strdup(
+    struct arena* arena,
+    const char* str
+) {
+    size_t len = strlen(str) + 1;
+    char* copy = arena_alloc(arena, len);
+    if (copy != NULL) memcpy(copy, str, len);
+    return copy;
+}
+
+static char** make_argv(
+    struct arena* arena,
+    size_t argc,
+    const char* args[]
+) {
+    char** argv = arena_alloc(arena, sizeof(*argv) * (argc + 1));
+    if (argv == NULL) return NULL;
+
+    for (size_t i = 0; i < argc; i++) {
+        if ((argv[i] = arena_strdup(arena, args[i])) == NULL) return NULL;
+    }
+    argv[argc] = NULL;
+    return argv;
+}
+
+static int wanted(
+    const struct bench_options* options,
+    const char* name
+) {
+    return options->filter == NULL || strstr(name, options->filter) != NULL;
+}
+
+static int fixture_wanted(
+    const struct bench_options* options,
+    const char* fixture
+) {
+    static const char* tools[] = { "search", "explore", "list" };
+    static const char* configs[] = { "fixed", "parallel" };
+    char name[BENCH_NAME_MAX];
+
+    for (size_t t = 0; t < sizeof(tools) / sizeof(tools[0]); t++) {
+        for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+            snprintf(name, sizeof(name), "%s/%s/%s", tools[t], fixture, configs[c]);
+            if (wanted(options, name)) return 1;
+        }
+    }
+    return 0;
+}
+
+// adds name with the same argv for every process; returns 0 when skipped by the filter
+static int add_case(
+    const struct bench_options* options,
+    struct bench_case* cases,
+    size_t* len,
+    const char* name,
+    int processes,
+    char** argv
+) {
+    if (!wanted(options, name)) return 0;
+    if (argv == NULL) return core_error(ERROR_MALLOC, "bench arena exhausted");
+    if (*len == BENCH_MAX_CASES) return core_error(ERROR_GENERIC, "too many bench cases");
+
+    struct bench_case* bench_case = &cases[(*len)++];
+    snprintf(bench_case->name, sizeof(bench_case->name), "%s", name);
+    bench_case->processes = processes;
+    for (int p = 0; p < processes; p++) bench_case->argv[p] = argv;
+    return 0;
+}
+
+static int add_fixture_cases(
+    const struct bench_options* options,
+    struct arena* arena,
+    const struct bench_fixture* fixture,
+    struct bench_case* cases,
+    size_t* len
+) {
+    char name[BENCH_NAME_MAX];
+    char jobs[16];
+
+    snprintf(jobs, sizeof(jobs), "%d", options->jobs);
+
+    const char* search_fixed[] = { BENCH_SEARCH, BENCH_NEEDLE, fixture->root };
+    const char* search_parallel[] = { BENCH_SEARCH, "-j", jobs, BENCH_NEEDLE, fixture->root };
+    const char* explore[] = { BENCH_EXPLORE, "-r", BENCH_TARGET, fixture->root };
+    const char* list[] = { BENCH_LIST, "-i", "-f", fixture->list_dir };
+    char** explore_argv = make_argv(arena, 4, explore);
+    char** list_argv = make_argv(arena, 4, list);
+
+    // search parallelizes internally; the other tools by running side by side
+    const struct {
+        const char* tool;
+        const char* config;
+        int processes;
+        char** argv;
+    } specs[] = {
+        { "search",  "fixed",    1,             make_argv(arena, 3, search_fixed)    },
+        { "search",  "parallel", 1,             make_argv(arena, 5, search_parallel) },
+        { "explore", "fixed",    1,             explore_argv                         },
+        { "explore", "parallel", options->jobs, explore_argv                         },
+        { "list",    "fixed",    1,             list_argv                            },
+        { "list",    "parallel", options->jobs, list_argv                            },
+    };
+
+    for (size_t i = 0; i < sizeof(specs) / sizeof(specs[0]); i++) {
+        snprintf(name, sizeof(name), "%s/%s/%s", specs[i].tool, fixture->name, specs[i].config);
+        int ret = add_case(options, cases, len, name, specs[i].processes, specs[i].argv);
+        if (ret != 0) return ret;
+    }
+
+    return 0;
+}
+
+// write has no input tree: each process writes its own set of files into a
+// directory that bench_run_case empties before every run
+static int add_write_cases(
+    const struct bench_options* options,
+    struct arena* arena,
+    const char* base,
+    struct bench_case* cases,
+    size_t* len
+) {
+    static const char* configs[] = { "fixed", "parallel" };
+    char content[1025];
+    char path[CORE_PATH_MAX];
+
+    memset(content, 'x', sizeof(content) - 1);
+    content[sizeof(content) - 1] = '\0';
+
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        char name[BENCH_NAME_MAX];
+        snprintf(name, sizeof(name), "write/many-files/%s", configs[c]);
+        if (!wanted(options, name)) continue;
+        if (*len == BENCH_MAX_CASES) return core_error(ERROR_GENERIC, "too many bench cases");
+
+        struct bench_case* bench_case = &cases[(*len)++];
+        snprintf(bench_case->name, sizeof(bench_case->name), "%s", name);
+        bench_case->processes = c == 0 ? 1 : options->jobs;
+
+        for (int p = 0; p < bench_case->processes; p++) {
+            char** argv = arena_alloc(arena, sizeof(*argv) * (BENCH_WRITE_FILES + 3));
+            if (argv == NULL) return core_error(ERROR_MALLOC, "bench arena exhausted");
+
+            char dir[32];
+            snprintf(dir, sizeof(dir), "write-%s-%d", configs[c], p);
+            if (core_path_join(path, sizeof(path), base, dir) != 0) return ERROR_PATH_TOO_LONG;
+            bench_case->fresh_dir[p] = arena_strdup(arena, path);
+
+            argv[0] = arena_strdup(arena, BENCH_WRITE);
+            argv[1] = arena_strdup(arena, content);
+            for (int i = 0; i < BENCH_WRITE_FILES; i++) {
+                char file_name[32];
+                char file[CORE_PATH_MAX];
+                snprintf(file_name, sizeof(file_name), "file%03d.txt", i);
+                if (core_path_join(file, sizeof(file), path, file_name) != 0) return ERROR_PATH_TOO_LONG;
+                argv[2 + i] = arena_strdup(arena, file);
+            }
+            argv[2 + BENCH_WRITE_FILES] = NULL;
+            bench_case->argv[p] = argv;
+        }
+    }
+
+    return 0;
+}
+
+static int parse_int(
+    const char* str,
+    int min,
+    int max,
+    int* value
+) {
+    char* end;
+    long parsed = strtol(str, &end, 10);
+    if (*end != '\0' || parsed < min || parsed > max) {
+        return core_error(ERROR_INVALID_OPTION, "invalid value: %s (expected %d..%d)", str, min, max);
+    }
+    *value = (int)parsed;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_options options = { .repeat = 5, .scale = 1 };
+    const char* output = NULL;
+    const char* baseline = NULL;
+    double threshold = 10.0;
+    int keep = 0;
+    char* end;
+
+    core_tool_init(&tool);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    options.jobs = cpus < 2 ? 2 : cpus > BENCH_MAX_PARALLEL ? BENCH_MAX_PARALLEL : (int)cpus;
+
+    static struct option long_options[] = {
+        { "output",    required_argument, 0, 'o' },
+        { "baseline",  required_argument, 0, 'b' },
+        { "threshold", required_argument, 0, 't' },
+        { "repeat",    required_argument, 0, 'r' },
+        { "jobs",      required_argument, 0, 'j' },
+        { "scale",     required_argument, 0, 's' },
+        { "filter",    required_argument, 0, 'f' },
+        { "keep",      no_argument,       0, 'k' },
+        { "verbose",   no_argument,       0, 'v' },
+        { "help",      no_argument,       0, 'h' },
+        { "version",   no_argument,       0, 'V' },
+        { 0,           0,                 0,  0  }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "o:b:t:r:j:s:f:kvhV", long_options, NULL)) != -1) {
+        int ret = 0;
+        switch (opt) {
+            case 'o':
+                output = optarg;
+                break;
+            case 'b':
+                baseline = optarg;
+                break;
+            case 't':
+                threshold = strtod(optarg, &end);
+                if (*end != '\0' || threshold < 0) ret = core_error(ERROR_INVALID_OPTION, "invalid threshold: %s", optarg);
+                break;
+            case 'r':
+                ret = parse_int(optarg, 1, 1000, &options.repeat);
+                break;
+            case 'j':
+                ret = parse_int(optarg, 1, BENCH_MAX_PARALLEL, &options.jobs);
+                break;
+            case 's':
+                ret = parse_int(optarg, 1, 64, &options.scale);
+                break;
+            case 'f':
+                options.filter = optarg;
+                break;
+            case 'k':
+                keep = 1;
+                break;
+            case 'v':
+                options.verbose = 1;
+                break;
+            default:
+                return core_finish(core_args_default(&tool, opt));
+        }
+        if (ret != 0) return core_finish(ret);
+    }
+
+    struct core_out* progress = malloc(sizeof(*progress));
+    struct bench_fixture* fixtures = calloc(sizeof(fixture_names) / sizeof(fixture_names[0]), sizeof(*fixtures));
+    struct bench_case* cases = calloc(BENCH_MAX_CASES, sizeof(*cases));
+    struct bench_result* results = calloc(BENCH_MAX_CASES, sizeof(*results));
+    struct arena arena = { .data = malloc(ARENA_SIZE), .cap = ARENA_SIZE };
+    size_t fixtures_len = 0;
+    size_t cases_len = 0;
+    size_t failed = 0;
+    int status = 0;
+    char base[CORE_PATH_MAX];
+
+    if (progress == NULL || fixtures == NULL || cases == NULL || results == NULL || arena.data == NULL) {
+        status = core_error(ERROR_MALLOC, "malloc failed");
+        goto done;
+    }
+    core_out_init(progress, STDERR_FILENO);
+
+    const char* tmpdir = getenv("TMPDIR");
+    snprintf(base, sizeof(base), "%s/bench.XXXXXX", tmpdir != NULL ? tmpdir : "/tmp");
+    if (mkdtemp(base) == NULL) {
+        status = core_error(ERROR_DIR_OPEN, "unable to create %s", base);
+        goto done;
+    }
+
+    // 1. fixtures
+    for (size_t i = 0; i < sizeof(fixture_names) / sizeof(fixture_names[0]) && status == 0; i++) {
+        if (!fixture_wanted(&options, fixture_names[i])) continue;
+        if (options.verbose) {
+            core_out_printf(progress, "[bench] building fixture %s\n", fixture_names[i]);
+            core_out_flush(progress);
+        }
+        struct bench_fixture* fixture = &fixtures[fixtures_len++];
+        status = bench_fixture_build(fixture, base, fixture_names[i], options.scale);
+        if (status == 0) status = add_fixture_cases(&options, &arena, fixture, cases, &cases_len);
+    }
+    if (status == 0) status = add_write_cases(&options, &arena, base, cases, &cases_len);
+
+    // 2. cases
+    for (size_t i = 0; i < cases_len && status == 0; i++) {
+        if (options.verbose) {
+            core_out_printf(progress, "[bench] running %s\n", cases[i].name);
+            core_out_flush(progress);
+        }
+        if (bench_run_case(&options, &cases[i], &results[i]) != 0) {
+            core_error(ERROR_GENERIC, "%s exited with status %d", cases[i].name, results[i].exit_status);
+            failed++;
+        }
+    }
+
+    // 3. report
+    if (status == 0 && (output != NULL || baseline == NULL)) {
+        struct core_out* out = &core_stdout;
+        struct core_out report;
+        if (output != NULL) {
+            status = core_out_open(&report, output, 0);
+            out = &report;
+        }
+        if (status == 0) {
+            bench_report_write(out, &options, fixtures, fixtures_len, results, cases_len);
+            if (output != NULL && core_out_close(out) != 0) status = core_error(ERROR_FWRITE, "failed to write %s", output);
+        }
+    }
+
+    // 4. comparison
+    if (status == 0 && baseline != NULL) {
+        struct bench_result* saved = NULL;
+        size_t saved_len = 0;
+        int saved_scale = 0;
+        status = bench_report_read(baseline, &saved, &saved_len, &saved_scale);
+        if (status == 0) {
+            if (saved_scale != options.scale) {
+                core_out_printf(progress, "[bench] warning: baseline was recorded at scale %d, this run is scale %d\n", saved_scale, options.scale);
+                core_out_flush(progress);
+            }
+            status = bench_report_compare(&options, saved, saved_len, results, cases_len, threshold);
+        }
+        free(saved);
+    }
+
+    // the report still covers every case, but a failing tool fails the run
+    if (status == 0 && failed > 0) status = core_error(ERROR_GENERIC, "%zu case(s) exited with a non-zero status", failed);
+
+    if (keep) core_out_printf(progress, "[bench] fixtures kept in %s\n", base);
+    else bench_remove_tree(base);
+
+done:
+    if (progress != NULL) core_out_close(progress);
+    free(arena.data);
+    free(results);
+    free(cases);
+    free(fixtures);
+    free(progress);
+    return core_finish(status);
+}
@@ -0,0 +1,300 @@
+#include <ctype.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "bench.h"
+
+#define REPORT_MAX_SIZE (4 * 1024 * 1024)
+
+static void write_json_string(
+    struct core_out* out,
+    const char* str
+) {
+    core_out_char(out, '"');
+    for (; *str != '\0'; str++) {
+        if (*str == '"' || *str == '\\') core_out_char(out, '\\');
+        core_out_char(out, *str);
+    }
+    core_out_char(out, '"');
+}
+
+static void write_json_int(
+    struct core_out* out,
+    int64_t value
+) {
+    if (value < 0) core_out_str(out, "null");
+    else core_out_i64(out, value);
+}
+
+int bench_report_write(
+    struct core_out* out,
+    const struct bench_options* options,
+    const struct bench_fixture* fixtures,
+    size_t fixtures_len,
+    const struct bench_result* results,
+    size_t results_len
+) {
+    core_out_str(out, "{\n  \"version\": 1,\n");
+    core_out_printf(out, "  \"scale\": %d,\n  \"jobs\": %d,\n  \"repeat\": %d,\n", options->scale, options->jobs, options->repeat);
+
+    core_out_str(out, "  \"fixtures\": [\n");
+    for (size_t i = 0; i < fixtures_len; i++) {
+        core_out_str(out, "    { \"name\": ");
+        write_json_string(out, fixtures[i].name);
+        core_out_str(out, ", \"files\": ");
+        core_out_u64(out, fixtures[i].files);
+        core_out_str(out, ", \"bytes\": ");
+        core_out_u64(out, fixtures[i].bytes);
+        core_out_str(out, i + 1 < fixtures_len ? " },\n" : " }\n");
+    }
+    core_out_str(out, "  ],\n");
+
+    core_out_str(out, "  \"cases\": [\n");
+    for (size_t i = 0; i < results_len; i++) {
+        const struct bench_result* result = &results[i];
+        core_out_str(out, "    { \"name\": ");
+        write_json_string(out, result->name);
+        core_out_printf(out, ", \"wall_ms_min\": %.3f, \"wall_ms_median\": %.3f", result->wall_ms_min, result->wall_ms_median);
+        core_out_str(out, ", \"syscalls\": ");
+        write_json_int(out, result->syscalls);
+        core_out_str(out, ", \"allocs\": ");
+        write_json_int(out, result->allocs);
+        core_out_str(out, ", \"alloc_bytes\": ");
+        write_json_int(out, result->alloc_bytes);
+        core_out_str(out, ", \"max_rss_kb\": ");
+        write_json_int(out, result->max_rss_kb);
+        core_out_str(out, ", \"exit_status\": ");
+        core_out_i64(out, result->exit_status);
+        core_out_str(out, i + 1 < results_len ? " },\n" : " }\n");
+    }
+    core_out_str(out, "  ]\n}\n");
+
+    return out->status;
+}
+
+static const char* skip_space(
+    const char* p
+) {
+    while (isspace((unsigned char)*p)) p++;
+    return p;
+}
+
+// reads a JSON string into dst; returns the position after it or NULL
+static const char* parse_string(
+    const char* p,
+    char* dst,
+    size_t size
+) {
+    size_t len = 0;
+
+    if (*p++ != '"') return NULL;
+    while (*p != '"') {
+        if (*p == '\0') return NULL;
+        if (*p == '\\' && p[1] != '\0') p++;
+        if (len + 1 < size) dst[len++] = *p;
+        p++;
+    }
+    dst[len] = '\0';
+    return p + 1;
+}
+
+// reads a number or null (stored as -1); returns the position after it or NULL
+static const char* parse_number(
+    const char* p,
+    double* value
+) {
+    if (strncmp(p, "null", 4) == 0) {
+        *value = -1;
+        return p + 4;
+    }
+
+    char* end;
+    *value = strtod(p, &end);
+    return end == p ? NULL : end;
+}
+
+// only the flat objects inside "cases" are read; everything else is ours to ignore
+static int parse_cases(
+    const char* p,
+    struct bench_result* results,
+    size_t* len,
+    size_t cap
+) {
+    p = strstr(p, "\"cases\"");
+    if (p == NULL || (p = strchr(p, '[')) == NULL) return -1;
+    p++;
+
+    *len = 0;
+    for (;;) {
+        p = skip_space(p);
+        if (*p == ']') return 0;
+        if (*p == ',') {
+            p++;
+            continue;
+        }
+        if (*p++ != '{' || *len == cap) return -1;
+
+        struct bench_result* result = &results[(*len)++];
+        memset(result, 0, sizeof(*result));
+        result->syscalls = result->allocs = result->alloc_bytes = result->max_rss_kb = -1;
+
+        for (;;) {
+            char key[32];
+            double value = 0;
+
+            p = skip_space(p);
+            if (*p == '}') {
+                p++;
+                break;
+            }
+            if (*p == ',') {
+                p++;
+                continue;
+            }
+            if ((p = parse_string(p, key, sizeof(key))) == NULL) return -1;
+            p = skip_space(p);
+            if (*p++ != ':') return -1;
+            p = skip_space(p);
+
+            if (strcmp(key, "name") == 0) {
+                if ((p = parse_string(p, result->name, sizeof(result->name))) == NULL) return -1;
+                continue;
+            }
+            if ((p = parse_number(p, &value)) == NULL) return -1;
+
+            if (strcmp(key, "wall_ms_min") == 0) result->wall_ms_min = value;
+            else if (strcmp(key, "wall_ms_median") == 0) result->wall_ms_median = value;
+            else if (strcmp(key, "syscalls") == 0) result->syscalls = (int64_t)value;
+            else if (strcmp(key, "allocs") == 0) result->allocs = (int64_t)value;
+            else if (strcmp(key, "alloc_bytes") == 0) result->alloc_bytes = (int64_t)value;
+            else if (strcmp(key, "max_rss_kb") == 0) result->max_rss_kb = (int64_t)value;
+            else if (strcmp(key, "exit_status") == 0) result->exit_status = (int)value;
+        }
+    }
+}
+
+int bench_report_read(
+    const char* path,
+    struct bench_result** results,
+    size_t* len,
+    int* scale
+) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return core_error(ERROR_FILE_OPEN, "failed to open baseline %s", path);
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size > REPORT_MAX_SIZE) {
+        close(fd);
+        return core_error(ERROR_FREAD, "baseline %s is not a bench report", path);
+    }
+
+    char* data = malloc((size_t)st.st_size + 1);
+    *results = malloc(sizeof(**results) * BENCH_MAX_CASES);
+    if (data == NULL || *results == NULL) {
+        close(fd);
+        free(data);
+        free(*results);
+        return core_error(ERROR_MALLOC, "malloc failed");
+    }
+
+    ssize_t nread = read(fd, data, (size_t)st.st_size);
+    close(fd);
+    data[nread > 0 ? nread : 0] = '\0';
+
+    const char* scale_key = strstr(data, "\"scale\"");
+    const char* colon = scale_key != NULL ? strchr(scale_key, ':') : NULL;
+    *scale = colon != NULL ? atoi(colon + 1) : 0;
+
+    int ret = parse_cases(data, *results, len, BENCH_MAX_CASES);
+    free(data);
+    if (ret != 0) {
+        free(*results);
+        *results = NULL;
+        return core_error(ERROR_FREAD, "baseline %s is not a bench report", path);
+    }
+
+    return 0;
+}
+
+static void write_change(
+    int64_t before,
+    int64_t after
+) {
+    if (before < 0 || after < 0) core_out_printf(&core_stdout, " %12s", "n/a");
+    else core_out_printf(&core_stdout, " %+12lld", (long long)(after - before));
+}
+
+static const struct bench_result* find_result(
+    const struct bench_result* results,
+    size_t len,
+    const char* name
+) {
+    for (size_t i = 0; i < len; i++) {
+        if (strcmp(results[i].name, name) == 0) return &results[i];
+    }
+    return NULL;
+}
+
+int bench_report_compare(
+    const struct bench_options* options,
+    const struct bench_result* baseline,
+    size_t baseline_len,
+    const struct bench_result* current,
+    size_t current_len,
+    double threshold
+) {
+    int regressions = 0;
+    int missing = 0;
+
+    core_out_printf(&core_stdout, "%-32s %11s %11s %8s %12s %12s %12s\n",
+        "case", "base ms", "now ms", "change", "syscalls", "allocs", "rss kb");
+
+    for (size_t i = 0; i < current_len; i++) {
+        const struct bench_result* now = &current[i];
+        const struct bench_result* base = find_result(baseline, baseline_len, now->name);
+        if (base == NULL) {
+            core_out_printf(&core_stdout, "%-32s %11s %11.3f   (new)\n", now->name, "-", now->wall_ms_median);
+            continue;
+        }
+
+        double change = base->wall_ms_median > 0
+            ? (now->wall_ms_median - base->wall_ms_median) / base->wall_ms_median * 100.0
+            : 0.0;
+        // tiny cases swing by whole percents on scheduler noise alone
+        int slower = change > threshold && now->wall_ms_median - base->wall_ms_median > BENCH_NOISE_FLOOR_MS;
+        // a tool that now fails early would otherwise pass as a speedup
+        int status_changed = now->exit_status != base->exit_status;
+        regressions += slower || status_changed;
+
+        core_out_printf(&core_stdout, "%-32s %11.3f %11.3f %+7.1f%%",
+            now->name, base->wall_ms_median, now->wall_ms_median, change);
+        write_change(base->syscalls, now->syscalls);
+        write_change(base->allocs, now->allocs);
+        write_change(base->max_rss_kb, now->max_rss_kb);
+        if (status_changed) {
+            core_out_printf(&core_stdout, "  REGRESSION (exit status %d, was %d)\n", now->exit_status, base->exit_status);
+        } else {
+            core_out_str(&core_stdout, slower ? "  REGRESSION\n" : "\n");
+        }
+    }
+
+    // a baseline case that didn't run is only expected when the filter left it out
+    for (size_t i = 0; i < baseline_len; i++) {
+        const struct bench_result* base = &baseline[i];
+        if (find_result(current, current_len, base->name) != NULL) continue;
+        if (options->filter != NULL && strstr(base->name, options->filter) == NULL) continue;
+
+        core_out_printf(&core_stdout, "%-32s %11.3f %11s   MISSING\n", base->name, base->wall_ms_median, "-");
+        missing++;
+    }
+
+    int status = 0;
+    if (regressions > 0) {
+        status = core_error(ERROR_GENERIC, "%d case(s) regressed: slower than baseline by more than %.1f%% or a different exit status",
+            regressions, threshold);
+    }
+    if (missing > 0) {
+        status = core_error(ERROR_GENERIC, "%d baseline case(s) missing from this run", missing);
+    }
+    return status;
+}
@@ -0,0 +1,222 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/ptrace.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "bench.h"
+
+enum child_mode {
+    CHILD_PLAIN,
+    CHILD_TRACED,
+    CHILD_ALLOC,
+};
+
+static pid_t spawn(
+    char** argv,
+    enum child_mode mode,
+    int alloc_fd
+) {
+    pid_t pid = fork();
+    if (pid != 0) return pid;
+
+    // the tool's own output isn't part of the measurement
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd != -1) {
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+        close(null_fd);
+    }
+
+    if (mode == CHILD_TRACED) {
+        if (ptrace(PTRACE_TRACEME, 0, NULL, NULL) == -1) _exit(127);
+        raise(SIGSTOP);
+    } else if (mode == CHILD_ALLOC) {
+        char fd_str[16];
+        snprintf(fd_str, sizeof(fd_str), "%d", alloc_fd);
+        setenv("BENCH_ALLOC_FD", fd_str, 1);
+        setenv("LD_PRELOAD", BENCH_ALLOC_SHIM, 1);
+    }
+
+    execv(argv[0], argv);
+    _exit(127);
+}
+
+static int exit_status(
+    int status
+) {
+    if (WIFEXITED(status)) return WEXITSTATUS(status);
+    return 128 + WTERMSIG(status);
+}
+
+// so every run writes new files instead of overwriting the previous run's
+static int reset_fresh_dirs(
+    const struct bench_case* bench_case
+) {
+    for (int p = 0; p < bench_case->processes; p++) {
+        const char* dir = bench_case->fresh_dir[p];
+        if (dir == NULL) continue;
+
+        if (access(dir, F_OK) == 0 && bench_remove_tree(dir) != 0) return ERROR_GENERIC;
+        if (mkdir(dir, 0755) == -1) {
+            return core_error(ERROR_DIR_OPEN, "unable to create directory %s: %s", dir, strerror(errno));
+        }
+    }
+    return 0;
+}
+
+static int compare_doubles(
+    const void* a,
+    const void* b
+) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// returns non-zero only when the case could not be set up; tool failures land in result
+static int run_timed(
+    const struct bench_options* options,
+    const struct bench_case* bench_case,
+    struct bench_result* result
+) {
+    double* times = malloc(sizeof(*times) * (size_t)options->repeat);
+    if (times == NULL) return result->exit_status = core_error(ERROR_MALLOC, "malloc failed");
+
+    for (int r = 0; r < options->repeat; r++) {
+        pid_t pids[BENCH_MAX_PARALLEL];
+
+        if (reset_fresh_dirs(bench_case) != 0) {
+            free(times);
+            return result->exit_status = ERROR_DIR_OPEN;
+        }
+        double start = core_now_ms();
+
+        for (int p = 0; p < bench_case->processes; p++) {
+            pids[p] = spawn(bench_case->argv[p], CHILD_PLAIN, -1);
+        }
+        for (int p = 0; p < bench_case->processes; p++) {
+            struct rusage usage;
+            int status;
+            if (pids[p] == -1 || wait4(pids[p], &status, 0, &usage) == -1) {
+                result->exit_status = ERROR_GENERIC;
+                continue;
+            }
+            if (usage.ru_maxrss > result->max_rss_kb) result->max_rss_kb = usage.ru_maxrss;
+            if (exit_status(status) != 0) result->exit_status = exit_status(status);
+        }
+
+        times[r] = core_now_ms() - start;
+    }
+
+    qsort(times, (size_t)options->repeat, sizeof(*times), compare_doubles);
+    result->wall_ms_min = times[0];
+    result->wall_ms_median = times[options->repeat / 2];
+    free(times);
+    return 0;
+}
+
+// counts syscall entries across all threads of one traced run, from exec onwards
+static int64_t count_syscalls(
+    char** argv
+) {
+    int status;
+    pid_t pid = spawn(argv, CHILD_TRACED, -1);
+    if (pid == -1) return -1;
+
+    if (waitpid(pid, &status, 0) == -1 || !WIFSTOPPED(status)) return -1;
+    long options = PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_TRACEEXEC | PTRACE_O_EXITKILL;
+    if (ptrace(PTRACE_SETOPTIONS, pid, NULL, (void*)options) == -1) {
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+        return -1;
+    }
+    ptrace(PTRACE_SYSCALL, pid, NULL, NULL);
+
+    int64_t count = 0;
+    int counting = 0;
+    pid_t tid;
+    while ((tid = waitpid(-1, &status, __WALL)) != -1) {
+        if (!WIFSTOPPED(status)) continue;
+
+        int sig = WSTOPSIG(status);
+        int deliver = 0;
+        if (sig == (SIGTRAP | 0x80)) {
+            struct __ptrace_syscall_info info;
+            if (counting
+                && ptrace(PTRACE_GET_SYSCALL_INFO, tid, (void*)sizeof(info), &info) > 0
+                && info.op == PTRACE_SYSCALL_INFO_ENTRY) {
+                count++;
+            }
+        } else if (sig == SIGTRAP && (status >> 16) != 0) {
+            if ((status >> 16) == PTRACE_EVENT_EXEC) counting = 1;
+        } else if (sig != SIGSTOP) {
+            // real signals go through; SIGSTOP here is a new thread starting
+            deliver = sig;
+        }
+        ptrace(PTRACE_SYSCALL, tid, NULL, (void*)(long)deliver);
+    }
+
+    return counting ? count : -1;
+}
+
+// runs once under the allocation-counting shim, which reports over a pipe
+static void count_allocs(
+    char** argv,
+    struct bench_result* result
+) {
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) == -1) return;
+
+    // only the write end is inherited by the tool
+    int child_fd = fcntl(fds[1], F_DUPFD, 3);
+    pid_t pid = child_fd == -1 ? -1 : spawn(argv, CHILD_ALLOC, child_fd);
+    if (child_fd != -1) close(child_fd);
+    close(fds[1]);
+
+    char buf[64];
+    size_t len = 0;
+    ssize_t nread;
+    while (len < sizeof(buf) - 1 && (nread = read(fds[0], buf + len, sizeof(buf) - 1 - len)) != 0) {
+        if (nread < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        len += (size_t)nread;
+    }
+    buf[len] = '\0';
+    close(fds[0]);
+
+    int status;
+    if (pid != -1) waitpid(pid, &status, 0);
+
+    long long allocs, bytes;
+    if (sscanf(buf, "%lld %lld", &allocs, &bytes) == 2) {
+        result->allocs = allocs;
+        result->alloc_bytes = bytes;
+    }
+}
+
+int bench_run_case(
+    const struct bench_options* options,
+    const struct bench_case* bench_case,
+    struct bench_result* result
+) {
+    memset(result, 0, sizeof(*result));
+    snprintf(result->name, sizeof(result->name), "%s", bench_case->name);
+    result->syscalls = -1;
+    result->allocs = -1;
+    result->alloc_bytes = -1;
+
+    if (run_timed(options, bench_case, result) != 0) return result->exit_status;
+
+    // counters come from separate single-instance runs so they don't skew timing
+    if (reset_fresh_dirs(bench_case) == 0) result->syscalls = count_syscalls(bench_case->argv[0]);
+    if (reset_fresh_dirs(bench_case) == 0) count_allocs(bench_case->argv[0], result);
+
+    return result->exit_status;
+}
@@ -0,0 +1,57 @@
+#include <getopt.h>
+#include <unistd.h>
+
+#include "core.h"
+
+int core_tool_init(
+    const struct core_tool* tool
+) {
+    core_set_progname(tool->name);
+
+    // make getopt start over in case a previous tool already parsed in-process
+    optind = 0;
+    return 0;
+}
+
+int core_args_default(
+    const struct core_tool* tool,
+    int opt
+) {
+    switch (opt) {
+        case 'h':
+            core_out_str(&core_stdout, tool->usage);
+            return 0;
+        case 'V':
+            core_out_str(&core_stdout, tool->version);
+            core_out_char(&core_stdout, '\n');
+            return 0;
+        default:
+            return core_error(
+                ERROR_INVALID_OPTION,
+                "unrecognized option detected. run with '-h'/'--help' to see valid options"
+            );
+    }
+}
+
+int core_args_require(
+    int argc,
+    const char* what
+) {
+    if (optind >= argc) {
+        return core_error(ERROR_MISSING_ARGUMENT, "no %s given", what);
+    }
+
+    return 0;
+}
+
+int core_finish(
+    int status
+) {
+    int out_status = core_out_flush(&core_stdout);
+    if (out_status != 0 && status == 0) {
+        status = core_error(out_status, "failed to write output");
+    }
+
+    core_stdout.status = 0;
+    return status;
+}
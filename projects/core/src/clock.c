@@ -0,0 +1,11 @@
+#define _GNU_SOURCE
+
+#include <time.h>
+
+#include "core.h"
+
+double core_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
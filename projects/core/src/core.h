@@ -0,0 +1,164 @@
+#ifndef CORE_H
+#define CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#define CORE_VERSION "1.0.0"
+
+// exit/status codes shared by every tool (0 is success)
+#define ERROR_GENERIC 1
+#define ERROR_INVALID_OPTION 2
+#define ERROR_MISSING_ARGUMENT 3
+#define ERROR_DIR_OPEN 4
+#define ERROR_DIR_CLOSE 5
+#define ERROR_FILE_OPEN 6
+#define ERROR_FREAD 7
+#define ERROR_FWRITE 8
+#define ERROR_MALLOC 9
+#define ERROR_PATH_TOO_LONG 10
+#define ERROR_INVALID_LOOKUP_CODE 11
+#define ERROR_CODE_COUNT 12
+
+#define CORE_PATH_MAX 4096
+#define CORE_OUT_BUF_SIZE (64 * 1024)
+#define CORE_FMT_U64_MAX 20
+
+// buffered output writer over a raw file descriptor; writers sharing an fd
+// across threads can share a lock so each flush lands as one unit, and
+// between core_out_begin/core_out_end the whole batch lands as one unit: a
+// batch that overflows the buffer holds the lock until core_out_end. a thread
+// batching on several writers that share one lock needs it to be recursive
+struct core_out {
+    int fd;
+    int owns_fd;
+    int status;
+    int batch;
+    int held;
+    pthread_mutex_t* lock;
+    size_t len;
+    char buf[CORE_OUT_BUF_SIZE];
+};
+
+extern struct core_out core_stdout;
+
+void core_out_init(struct core_out*, int);
+
+int core_out_open(struct core_out*, const char*, int);
+
+int core_out_flush(struct core_out*);
+
+int core_out_close(struct core_out*);
+
+void core_out_begin(struct core_out*);
+
+int core_out_end(struct core_out*);
+
+int core_out_write(struct core_out*, const char*, size_t);
+
+int core_out_str(struct core_out*, const char*);
+
+int core_out_char(struct core_out*, char);
+
+int core_out_u64(struct core_out*, uint64_t);
+
+int core_out_i64(struct core_out*, int64_t);
+
+int core_out_printf(struct core_out*, const char*, ...)
+    __attribute__((format(printf, 2, 3)));
+
+// writes all of data to fd, retrying short writes and EINTR; -1 on failure
+int core_write_all(int, const void*, size_t);
+
+// monotonic clock in milliseconds, for timing and deadlines
+double core_now_ms(void);
+
+// integer formatting; returns the number of characters written (no NUL)
+size_t core_fmt_u64(char*, uint64_t);
+
+size_t core_fmt_i64(char*, int64_t);
+
+// recoverable error reporting
+void core_set_progname(const char*);
+
+const char* core_progname(void);
+
+int core_error(int, const char*, ...)
+    __attribute__((format(printf, 2, 3)));
+
+int core_last_error(void);
+
+const char* core_error_name(int);
+
+const char* core_error_describe(int);
+
+// directory iteration
+#define CORE_DIR_SKIP_DOTS 0x1
+
+struct core_dir_listing;
+
+struct core_dir {
+    DIR* dir;
+    const char* path;
+    int flags;
+    struct core_dir_listing* listing;
+    size_t pos;
+};
+
+struct core_dirent {
+    const char* name;
+    unsigned char type;
+    ino_t ino;
+};
+
+int core_dir_open(struct core_dir*, const char*, int);
+
+int core_dir_openat(struct core_dir*, int, const char*, const char*, int);
+
+int core_dir_fd(const struct core_dir*);
+
+int core_dir_next(struct core_dir*, struct core_dirent*);
+
+int core_dir_close(struct core_dir*);
+
+int core_path_join(char*, size_t, const char*, const char*);
+
+// recursive traversal; in recursive mode directories are descended into
+// (when descend allows) instead of visited, otherwise every entry is visited
+struct core_walk {
+    int recursive;
+    void* ctx;
+    int (*visit)(struct core_walk*, int, const char*, const struct core_dirent*);
+    int (*descend)(struct core_walk*, const char*, const struct core_dirent*);
+    void (*enter)(struct core_walk*, int, const char*);
+    void (*leave)(struct core_walk*, const char*);
+};
+
+int core_walk_dir(struct core_walk*, int, const char*, const char*);
+
+// keep listings (and their fds) of opened directories across core_dir_open
+// calls, revalidated by mtime/ctime; meant for long-running processes
+void core_dir_cache_enable(size_t);
+
+void core_dir_cache_clear(void);
+
+// argument handling shared by every tool's getopt loop
+struct core_tool {
+    const char* name;
+    const char* version;
+    const char* usage;
+};
+
+int core_tool_init(const struct core_tool*);
+
+int core_args_default(const struct core_tool*, int);
+
+int core_args_require(int, const char*);
+
+int core_finish(int);
+
+#endif
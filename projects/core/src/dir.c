@@ -0,0 +1,396 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "core.h"
+
+#define CACHE_BUCKETS 1024
+// directory timestamps tick coarsely; a listing read this soon after the last
+// change can't tell a later change in the same tick apart, so it is re-read
+#define CACHE_RACY_SECONDS 2
+
+struct listing_entry {
+    size_t name_off;
+    ino_t ino;
+    unsigned char type;
+};
+
+struct core_dir_listing {
+    dev_t dev;
+    ino_t ino;
+    struct timespec mtime;
+    struct timespec ctime;
+    int fd;
+    int users;
+    int racy;
+    size_t count;
+    struct listing_entry* entries;
+    char* names;
+    size_t bucket;
+    struct core_dir_listing* next;
+    // recency order across all buckets, most recently used first
+    struct core_dir_listing* lru_prev;
+    struct core_dir_listing* lru_next;
+};
+
+static struct core_dir_listing* cache[CACHE_BUCKETS];
+static struct core_dir_listing* lru_head = NULL;
+static struct core_dir_listing* lru_tail = NULL;
+static size_t cache_max = 0;
+static size_t cache_size = 0;
+
+static unsigned char type_from_mode(
+    mode_t mode
+) {
+    if (S_ISREG(mode)) return DT_REG;
+    if (S_ISDIR(mode)) return DT_DIR;
+    if (S_ISLNK(mode)) return DT_LNK;
+    if (S_ISFIFO(mode)) return DT_FIFO;
+    if (S_ISSOCK(mode)) return DT_SOCK;
+    if (S_ISCHR(mode)) return DT_CHR;
+    if (S_ISBLK(mode)) return DT_BLK;
+    return DT_UNKNOWN;
+}
+
+static unsigned char resolve_type(
+    int fd,
+    const char* name,
+    unsigned char type
+) {
+    // some filesystems don't fill d_type; only then pay for a stat
+    if (type == DT_UNKNOWN) {
+        struct stat st;
+        if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+            type = type_from_mode(st.st_mode);
+        }
+    }
+    return type;
+}
+
+static int is_dots(
+    const char* name
+) {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+static int same_time(
+    const struct timespec* a,
+    const struct timespec* b
+) {
+    return a->tv_sec == b->tv_sec && a->tv_nsec == b->tv_nsec;
+}
+
+static int is_racy(
+    const struct stat* st
+) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    time_t newest = st->st_mtim.tv_sec > st->st_ctim.tv_sec ? st->st_mtim.tv_sec : st->st_ctim.tv_sec;
+    return now.tv_sec - newest < CACHE_RACY_SECONDS;
+}
+
+static void listing_free(
+    struct core_dir_listing* listing
+) {
+    close(listing->fd);
+    free(listing->entries);
+    free(listing->names);
+    free(listing);
+}
+
+static int listing_fill(
+    struct core_dir_listing* listing
+) {
+    // read through a dup so the cached fd stays open after closedir
+    int fd = dup(listing->fd);
+    if (fd == -1) return -1;
+    DIR* dir = fdopendir(fd);
+    if (dir == NULL) {
+        close(fd);
+        return -1;
+    }
+    rewinddir(dir);
+
+    size_t count = 0, cap = 0, names_len = 0, names_cap = 0;
+    struct listing_entry* entries = NULL;
+    char* names = NULL;
+    struct dirent* entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        size_t len = strlen(entry->d_name) + 1;
+
+        if (count == cap) {
+            cap = cap ? cap * 2 : 32;
+            struct listing_entry* grown = realloc(entries, cap * sizeof(*entries));
+            if (grown == NULL) goto fail;
+            entries = grown;
+        }
+        if (names_len + len > names_cap) {
+            names_cap = names_cap ? names_cap * 2 : 1024;
+            while (names_len + len > names_cap) names_cap *= 2;
+            char* grown = realloc(names, names_cap);
+            if (grown == NULL) goto fail;
+            names = grown;
+        }
+
+        memcpy(names + names_len, entry->d_name, len);
+        entries[count].name_off = names_len;
+        entries[count].ino = entry->d_ino;
+        entries[count].type = resolve_type(listing->fd, entry->d_name, entry->d_type);
+        names_len += len;
+        count++;
+    }
+    closedir(dir);
+
+    free(listing->entries);
+    free(listing->names);
+    listing->entries = entries;
+    listing->names = names;
+    listing->count = count;
+    return 0;
+
+fail:
+    closedir(dir);
+    free(entries);
+    free(names);
+    return -1;
+}
+
+static void lru_unlink(
+    struct core_dir_listing* listing
+) {
+    if (listing->lru_prev != NULL) listing->lru_prev->lru_next = listing->lru_next;
+    else lru_head = listing->lru_next;
+    if (listing->lru_next != NULL) listing->lru_next->lru_prev = listing->lru_prev;
+    else lru_tail = listing->lru_prev;
+    listing->lru_prev = listing->lru_next = NULL;
+}
+
+static void lru_push_front(
+    struct core_dir_listing* listing
+) {
+    listing->lru_prev = NULL;
+    listing->lru_next = lru_head;
+    if (lru_head != NULL) lru_head->lru_prev = listing;
+    else lru_tail = listing;
+    lru_head = listing;
+}
+
+static void cache_remove(
+    struct core_dir_listing* listing
+) {
+    struct core_dir_listing** link = &cache[listing->bucket];
+    while (*link != listing) link = &(*link)->next;
+    *link = listing->next;
+
+    lru_unlink(listing);
+    listing_free(listing);
+    cache_size--;
+}
+
+// drops the least recently used listing nobody is iterating; 0 if all are in use
+static int cache_evict_one(void) {
+    for (struct core_dir_listing* listing = lru_tail; listing != NULL; listing = listing->lru_prev) {
+        if (listing->users == 0) {
+            cache_remove(listing);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// returns a listing for parent_fd/name, or NULL to fall back to a plain opendir
+static struct core_dir_listing* cache_lookup(
+    int parent_fd,
+    const char* name
+) {
+    struct stat st;
+    if (fstatat(parent_fd, name, &st, 0) == -1 || !S_ISDIR(st.st_mode)) return NULL;
+
+    size_t bucket = (size_t)(st.st_ino ^ (st.st_dev << 7)) % CACHE_BUCKETS;
+    struct core_dir_listing* listing;
+    for (listing = cache[bucket]; listing != NULL; listing = listing->next) {
+        if (listing->dev == st.st_dev && listing->ino == st.st_ino) break;
+    }
+
+    if (listing != NULL) {
+        lru_unlink(listing);
+        lru_push_front(listing);
+        if (!listing->racy && same_time(&listing->mtime, &st.st_mtim) && same_time(&listing->ctime, &st.st_ctim)) {
+            return listing;
+        }
+        // stale; refresh in place unless someone is still iterating it
+        if (listing->users > 0 || listing_fill(listing) == -1) return NULL;
+        listing->mtime = st.st_mtim;
+        listing->ctime = st.st_ctim;
+        listing->racy = is_racy(&st);
+        return listing;
+    }
+
+    if (cache_size >= cache_max && !cache_evict_one()) return NULL;
+
+    listing = calloc(1, sizeof(*listing));
+    if (listing == NULL) return NULL;
+    listing->fd = openat(parent_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (listing->fd == -1) {
+        free(listing);
+        return NULL;
+    }
+    if (listing_fill(listing) == -1) {
+        listing_free(listing);
+        return NULL;
+    }
+    listing->dev = st.st_dev;
+    listing->ino = st.st_ino;
+    listing->mtime = st.st_mtim;
+    listing->ctime = st.st_ctim;
+    listing->racy = is_racy(&st);
+    listing->bucket = bucket;
+    listing->next = cache[bucket];
+    cache[bucket] = listing;
+    lru_push_front(listing);
+    cache_size++;
+    return listing;
+}
+
+void core_dir_cache_enable(
+    size_t max_dirs
+) {
+    cache_max = max_dirs;
+}
+
+void core_dir_cache_clear(void) {
+    struct core_dir_listing* listing = lru_head;
+    while (listing != NULL) {
+        struct core_dir_listing* next = listing->lru_next;
+        if (listing->users == 0) cache_remove(listing);
+        listing = next;
+    }
+}
+
+int core_dir_open(
+    struct core_dir* d,
+    const char* path,
+    int flags
+) {
+    return core_dir_openat(d, AT_FDCWD, path, path, flags);
+}
+
+int core_dir_openat(
+    struct core_dir* d,
+    int parent_fd,
+    const char* name,
+    const char* path,
+    int flags
+) {
+    d->dir = NULL;
+    d->path = path;
+    d->flags = flags;
+    d->listing = NULL;
+    d->pos = 0;
+
+    if (cache_max > 0) {
+        d->listing = cache_lookup(parent_fd, name);
+        if (d->listing != NULL) {
+            d->listing->users++;
+            return 0;
+        }
+    }
+
+    // openat relative to the parent avoids re-resolving the full path each level
+    int fd = openat(parent_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd != -1) {
+        d->dir = fdopendir(fd);
+        if (d->dir == NULL) close(fd);
+    }
+    if (d->dir == NULL) {
+        return core_error(ERROR_DIR_OPEN, "unable to open directory %s: %s", path, strerror(errno));
+    }
+
+    return 0;
+}
+
+int core_dir_fd(
+    const struct core_dir* d
+) {
+    if (d->listing != NULL) return d->listing->fd;
+    return dirfd(d->dir);
+}
+
+int core_dir_next(
+    struct core_dir* d,
+    struct core_dirent* ent
+) {
+    int skip_dots = d->flags & CORE_DIR_SKIP_DOTS;
+
+    if (d->listing != NULL) {
+        while (d->pos < d->listing->count) {
+            const struct listing_entry* cached = &d->listing->entries[d->pos++];
+            const char* name = d->listing->names + cached->name_off;
+            if (skip_dots && is_dots(name)) continue;
+
+            ent->name = name;
+            ent->ino = cached->ino;
+            ent->type = cached->type;
+            return 1;
+        }
+        return 0;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(d->dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (skip_dots && is_dots(name)) continue;
+
+        ent->name = name;
+        ent->ino = entry->d_ino;
+        ent->type = resolve_type(dirfd(d->dir), name, entry->d_type);
+        return 1;
+    }
+
+    return 0;
+}
+
+int core_dir_close(
+    struct core_dir* d
+) {
+    if (d->listing != NULL) {
+        d->listing->users--;
+        d->listing = NULL;
+        return 0;
+    }
+    if (d->dir == NULL) return 0;
+
+    int ret = closedir(d->dir);
+    d->dir = NULL;
+    if (ret == -1) {
+        return core_error(ERROR_DIR_CLOSE, "unable to close directory %s", d->path);
+    }
+
+    return 0;
+}
+
+int core_path_join(
+    char* dst,
+    size_t size,
+    const char* dir,
+    const char* name
+) {
+    size_t dir_len = strlen(dir);
+    size_t name_len = strlen(name);
+
+    if (dir_len + 1 + name_len + 1 > size) {
+        return core_error(ERROR_PATH_TOO_LONG, "path too long: %s/%s", dir, name);
+    }
+
+    memcpy(dst, dir, dir_len);
+    dst[dir_len] = '/';
+    memcpy(dst + dir_len + 1, name, name_len + 1);
+    return 0;
+}
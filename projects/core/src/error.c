@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "core.h"
+
+static const char* progname = "core";
+static _Thread_local int last_error = 0;
+
+static const struct {
+    const char* name;
+    const char* description;
+} errors[ERROR_CODE_COUNT] = {
+    [0] = { "OK", "The program completed successfully." },
+    [ERROR_GENERIC] = {
+        "ERROR_GENERIC",
+        "The program has failed for a nonspecific reason."
+    },
+    [ERROR_INVALID_OPTION] = {
+        "ERROR_INVALID_OPTION",
+        "The program was given an unrecognized option or argument.\n"
+        "Run with '-h' or '--help' to see available options."
+    },
+    [ERROR_MISSING_ARGUMENT] = {
+        "ERROR_MISSING_ARGUMENT",
+        "The program was not given a required positional argument.\n"
+        "Run with '-h' or '--help' to see CLI syntax."
+    },
+    [ERROR_DIR_OPEN] = {
+        "ERROR_DIR_OPEN",
+        "The program was unable to open the given directory by name.\n"
+        "Ensure all given directory values are valid paths."
+    },
+    [ERROR_DIR_CLOSE] = {
+        "ERROR_DIR_CLOSE",
+        "The program was unable to close a given directory after opening it."
+    },
+    [ERROR_FILE_OPEN] = {
+        "ERROR_FILE_OPEN",
+        "The program was unable to open the given file by name.\n"
+        "Ensure the given file name exists and is available to use."
+    },
+    [ERROR_FREAD] = {
+        "ERROR_FREAD",
+        "The program failed while reading from a file."
+    },
+    [ERROR_FWRITE] = {
+        "ERROR_FWRITE",
+        "The program failed while writing its output."
+    },
+    [ERROR_MALLOC] = {
+        "ERROR_MALLOC",
+        "The program was unable to allocate memory."
+    },
+    [ERROR_PATH_TOO_LONG] = {
+        "ERROR_PATH_TOO_LONG",
+        "A path encountered by the program exceeded the maximum supported length."
+    },
+    [ERROR_INVALID_LOOKUP_CODE] = {
+        "ERROR_INVALID_LOOKUP_CODE",
+        "The program was given an unrecognized lookup code."
+    },
+};
+
+void core_set_progname(
+    const char* name
+) {
+    const char* slash = strrchr(name, '/');
+    progname = slash != NULL ? slash + 1 : name;
+}
+
+const char* core_progname(void) {
+    return progname;
+}
+
+int core_error(
+    int code,
+    const char* format,
+    ...
+) {
+    char msg[CORE_PATH_MAX + 256];
+    va_list args;
+
+    int len = snprintf(msg, sizeof(msg), "%s: ", progname);
+    va_start(args, format);
+    len += vsnprintf(msg + len, sizeof(msg) - (size_t)len - 1, format, args);
+    va_end(args);
+    if ((size_t)len > sizeof(msg) - 2) len = (int)sizeof(msg) - 2;
+    msg[len++] = '\n';
+
+    // one write per message so concurrent reports don't interleave
+    ssize_t ret = write(STDERR_FILENO, msg, (size_t)len);
+    (void)ret;
+
+    last_error = code;
+    return code;
+}
+
+int core_last_error(void) {
+    return last_error;
+}
+
+const char* core_error_name(
+    int code
+) {
+    if (code < 0 || code >= ERROR_CODE_COUNT) return NULL;
+    return errors[code].name;
+}
+
+const char* core_error_describe(
+    int code
+) {
+    if (code < 0 || code >= ERROR_CODE_COUNT) return NULL;
+    return errors[code].description;
+}
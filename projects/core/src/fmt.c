@@ -0,0 +1,54 @@
+#include <string.h>
+
+#include "core.h"
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+size_t core_fmt_u64(
+    char* dst,
+    uint64_t value
+) {
+    char tmp[CORE_FMT_U64_MAX];
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
+
+    // emit two digits at a time from the back
+    while (value >= 100) {
+        size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    if (value >= 10) {
+        size_t pair = (size_t)value * 2;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    } else {
+        *--p = (char)('0' + value);
+    }
+
+    size_t len = (size_t)(end - p);
+    memcpy(dst, p, len);
+    return len;
+}
+
+size_t core_fmt_i64(
+    char* dst,
+    int64_t value
+) {
+    if (value >= 0) return core_fmt_u64(dst, (uint64_t)value);
+
+    // negate in unsigned space so INT64_MIN is safe
+    dst[0] = '-';
+    return 1 + core_fmt_u64(dst + 1, (uint64_t)0 - (uint64_t)value);
+}
@@ -0,0 +1,205 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "core.h"
+
+struct core_out core_stdout = { .fd = STDOUT_FILENO };
+
+int core_write_all(
+    int fd,
+    const void* data,
+    size_t len
+) {
+    const char* p = data;
+    while (len > 0) {
+        ssize_t ret = write(fd, p, len);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += ret;
+        len -= (size_t)ret;
+    }
+    return 0;
+}
+
+static void write_out(
+    struct core_out* out,
+    const char* data,
+    size_t len
+) {
+    // a batch that outgrows the buffer takes the lock and keeps it until
+    // core_out_end, so the rest of the batch streams out in one piece
+    if (out->lock != NULL && !out->held) pthread_mutex_lock(out->lock);
+    if (out->batch) out->held = 1;
+    if (core_write_all(out->fd, data, len) == -1) out->status = ERROR_FWRITE;
+    if (out->lock != NULL && !out->held) pthread_mutex_unlock(out->lock);
+}
+
+void core_out_init(
+    struct core_out* out,
+    int fd
+) {
+    out->fd = fd;
+    out->owns_fd = 0;
+    out->status = 0;
+    out->batch = 0;
+    out->held = 0;
+    out->lock = NULL;
+    out->len = 0;
+}
+
+int core_out_open(
+    struct core_out* out,
+    const char* path,
+    int append
+) {
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+    int fd = open(path, flags, 0666);
+    if (fd == -1) {
+        return core_error(ERROR_FILE_OPEN, "failed to open %s: %s", path, strerror(errno));
+    }
+
+    core_out_init(out, fd);
+    out->owns_fd = 1;
+    return 0;
+}
+
+int core_out_flush(
+    struct core_out* out
+) {
+    if (out->len > 0 && out->status == 0) write_out(out, out->buf, out->len);
+    out->len = 0;
+    return out->status;
+}
+
+int core_out_close(
+    struct core_out* out
+) {
+    int status = out->batch ? core_out_end(out) : core_out_flush(out);
+    if (out->owns_fd) {
+        if (close(out->fd) == -1 && status == 0) status = ERROR_FWRITE;
+        out->owns_fd = 0;
+    }
+    out->fd = -1;
+    return status;
+}
+
+void core_out_begin(
+    struct core_out* out
+) {
+    core_out_flush(out);
+    out->batch = 1;
+}
+
+int core_out_end(
+    struct core_out* out
+) {
+    core_out_flush(out);
+    out->batch = 0;
+    if (out->held) {
+        pthread_mutex_unlock(out->lock);
+        out->held = 0;
+    }
+    return out->status;
+}
+
+int core_out_write(
+    struct core_out* out,
+    const char* data,
+    size_t len
+) {
+    if (len > sizeof(out->buf) - out->len) {
+        if (core_out_flush(out) != 0) return out->status;
+
+        // large writes skip the buffer entirely
+        if (len >= sizeof(out->buf)) {
+            write_out(out, data, len);
+            return out->status;
+        }
+    }
+
+    memcpy(out->buf + out->len, data, len);
+    out->len += len;
+    return out->status;
+}
+
+int core_out_str(
+    struct core_out* out,
+    const char* str
+) {
+    return core_out_write(out, str, strlen(str));
+}
+
+int core_out_char(
+    struct core_out* out,
+    char c
+) {
+    if (out->len == sizeof(out->buf) && core_out_flush(out) != 0) return out->status;
+    out->buf[out->len++] = c;
+    return out->status;
+}
+
+int core_out_u64(
+    struct core_out* out,
+    uint64_t value
+) {
+    char digits[CORE_FMT_U64_MAX];
+    return core_out_write(out, digits, core_fmt_u64(digits, value));
+}
+
+int core_out_i64(
+    struct core_out* out,
+    int64_t value
+) {
+    char digits[CORE_FMT_U64_MAX + 1];
+    return core_out_write(out, digits, core_fmt_i64(digits, value));
+}
+
+int core_out_printf(
+    struct core_out* out,
+    const char* format,
+    ...
+) {
+    va_list args;
+    size_t room = sizeof(out->buf) - out->len;
+
+    va_start(args, format);
+    int len = vsnprintf(out->buf + out->len, room, format, args);
+    va_end(args);
+    if (len < 0) return out->status;
+
+    if ((size_t)len < room) {
+        out->len += (size_t)len;
+        return out->status;
+    }
+
+    // didn't fit: flush and either retry in the empty buffer or go unbuffered
+    if (core_out_flush(out) != 0) return out->status;
+
+    char* big = NULL;
+    char* dst = out->buf;
+    if ((size_t)len >= sizeof(out->buf)) {
+        big = malloc((size_t)len + 1);
+        if (big == NULL) return out->status = ERROR_MALLOC;
+        dst = big;
+    }
+
+    va_start(args, format);
+    vsnprintf(dst, (size_t)len + 1, format, args);
+    va_end(args);
+
+    if (big != NULL) {
+        write_out(out, big, (size_t)len);
+        free(big);
+    } else {
+        out->len = (size_t)len;
+    }
+    return out->status;
+}
@@ -0,0 +1,46 @@
+#include "core.h"
+
+int core_walk_dir(
+    struct core_walk* walk,
+    int parent_fd,
+    const char* name,
+    const char* dir_path
+) {
+    struct core_dir dir;
+    struct core_dirent entry;
+    int status = 0;
+
+    // only a recursive walk needs to skip . and ..; a flat one visits them like readdir
+    int flags = walk->recursive ? CORE_DIR_SKIP_DOTS : 0;
+    if (core_dir_openat(&dir, parent_fd, name, dir_path, flags) != 0) return ERROR_DIR_OPEN;
+
+    if (walk->enter != NULL) walk->enter(walk, core_dir_fd(&dir), dir_path);
+
+    while (core_dir_next(&dir, &entry)) {
+        if (walk->recursive && entry.type == DT_DIR) {
+            char path[CORE_PATH_MAX];
+
+            if (walk->descend != NULL && !walk->descend(walk, dir_path, &entry)) continue;
+
+            // construct new path for recursive checking
+            if (core_path_join(path, sizeof(path), dir_path, entry.name) != 0) {
+                status = ERROR_PATH_TOO_LONG;
+                continue;
+            }
+
+            // recurse, opening the child relative to this directory
+            int ret = core_walk_dir(walk, core_dir_fd(&dir), entry.name, path);
+            if (ret != 0) status = ret;
+            continue;
+        }
+
+        int ret = walk->visit(walk, core_dir_fd(&dir), dir_path, &entry);
+        if (ret != 0) status = ret;
+    }
+
+    if (core_dir_close(&dir) != 0) status = ERROR_DIR_CLOSE;
+
+    if (walk->leave != NULL) walk->leave(walk, dir_path);
+
+    return status;
+}
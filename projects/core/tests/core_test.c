@@ -0,0 +1,220 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "core.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+static char root[CORE_PATH_MAX];
+
+static void make_path(
+    char* path,
+    const char* rel
+) {
+    CHECK(core_path_join(path, CORE_PATH_MAX, root, rel) == 0);
+}
+
+static void touch(
+    const char* rel
+) {
+    char path[CORE_PATH_MAX];
+    make_path(path, rel);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    CHECK(fd != -1);
+    if (fd != -1) close(fd);
+}
+
+static void make_dir(
+    const char* rel
+) {
+    char path[CORE_PATH_MAX];
+    make_path(path, rel);
+    CHECK(mkdir(path, 0755) == 0);
+}
+
+static int remove_entry(
+    const char* path,
+    const struct stat* st,
+    int type,
+    struct FTW* ftw
+) {
+    (void)st;
+    (void)type;
+    (void)ftw;
+    return remove(path) == -1 ? -1 : 0;
+}
+
+// opens rel through the listing cache and reports whether name is in it
+static int dir_has(
+    const char* rel,
+    const char* name
+) {
+    char path[CORE_PATH_MAX];
+    struct core_dir dir;
+    struct core_dirent entry;
+    int found = 0;
+
+    make_path(path, rel);
+    if (core_dir_open(&dir, path, CORE_DIR_SKIP_DOTS) != 0) return -1;
+    while (core_dir_next(&dir, &entry)) {
+        if (strcmp(entry.name, name) == 0) found = 1;
+    }
+    core_dir_close(&dir);
+    return found;
+}
+
+// the fd a cached listing of rel pins, or -1 when it isn't cached
+static int cached_fd(
+    const char* rel
+) {
+    char path[CORE_PATH_MAX];
+    struct core_dir dir;
+
+    make_path(path, rel);
+    if (core_dir_open(&dir, path, 0) != 0) return -1;
+    int fd = dir.listing != NULL ? core_dir_fd(&dir) : -1;
+    core_dir_close(&dir);
+    return fd;
+}
+
+// true while fd is still the one opened for rel
+static int fd_is(
+    int fd,
+    const char* rel
+) {
+    char path[CORE_PATH_MAX];
+    struct stat fd_st;
+    struct stat path_st;
+
+    make_path(path, rel);
+    return fstat(fd, &fd_st) == 0 && stat(path, &path_st) == 0
+        && fd_st.st_dev == path_st.st_dev && fd_st.st_ino == path_st.st_ino;
+}
+
+static void test_cache_revalidates(void) {
+    char path[CORE_PATH_MAX];
+
+    core_dir_cache_enable(8);
+    make_dir("watched");
+    touch("watched/old.txt");
+
+    CHECK(dir_has("watched", "old.txt") == 1);
+    CHECK(dir_has("watched", "new.txt") == 0);
+
+    // adding and removing entries changes the directory's mtime/ctime
+    touch("watched/new.txt");
+    CHECK(dir_has("watched", "new.txt") == 1);
+
+    make_path(path, "watched/old.txt");
+    CHECK(unlink(path) == 0);
+    CHECK(dir_has("watched", "old.txt") == 0);
+    CHECK(dir_has("watched", "new.txt") == 1);
+
+    core_dir_cache_clear();
+    core_dir_cache_enable(0);
+}
+
+static void test_cache_evicts_least_recent(void) {
+    core_dir_cache_enable(2);
+    make_dir("lru_a");
+    make_dir("lru_b");
+    make_dir("lru_c");
+
+    int fd_a = cached_fd("lru_a");
+    int fd_b = cached_fd("lru_b");
+    CHECK(fd_a != -1 && fd_b != -1);
+
+    // touch a again so b is the least recently used when c needs room
+    CHECK(cached_fd("lru_a") == fd_a);
+    int fd_c = cached_fd("lru_c");
+    CHECK(fd_c != -1);
+
+    CHECK(fd_is(fd_a, "lru_a"));
+    CHECK(cached_fd("lru_a") == fd_a);
+    CHECK(!fd_is(fd_b, "lru_b"));
+
+    core_dir_cache_clear();
+    core_dir_cache_enable(0);
+}
+
+static off_t file_size(
+    const char* path
+) {
+    struct stat st;
+    return stat(path, &st) == 0 ? st.st_size : -1;
+}
+
+static void test_batch_overflow_streams(void) {
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    char path[CORE_PATH_MAX];
+    char chunk[1000];
+    struct core_out out;
+    off_t total = 300 * (off_t)sizeof(chunk);
+
+    make_path(path, "batch.out");
+    CHECK(core_out_open(&out, path, 0) == 0);
+    out.lock = &lock;
+    memset(chunk, 'x', sizeof(chunk));
+
+    core_out_begin(&out);
+    for (int i = 0; i < 300; i++) CHECK(core_out_write(&out, chunk, sizeof(chunk)) == 0);
+
+    // past the buffer, the batch is written through instead of piling up in memory
+    CHECK(file_size(path) >= total - CORE_OUT_BUF_SIZE);
+    // and keeps the lock so nobody else's output lands in the middle of it
+    int busy = pthread_mutex_trylock(&lock);
+    CHECK(busy == EBUSY);
+    if (busy == 0) pthread_mutex_unlock(&lock);
+
+    CHECK(core_out_end(&out) == 0);
+    CHECK(file_size(path) == total);
+    CHECK(pthread_mutex_trylock(&lock) == 0);
+    pthread_mutex_unlock(&lock);
+
+    // a batch that fits in the buffer never takes the lock early
+    core_out_begin(&out);
+    CHECK(core_out_write(&out, chunk, sizeof(chunk)) == 0);
+    CHECK(file_size(path) == total);
+    CHECK(pthread_mutex_trylock(&lock) == 0);
+    pthread_mutex_unlock(&lock);
+    CHECK(core_out_close(&out) == 0);
+    CHECK(file_size(path) == total + (off_t)sizeof(chunk));
+}
+
+int main(void) {
+    const char* tmpdir = getenv("TMPDIR");
+    snprintf(root, sizeof(root), "%s/core_test.XXXXXX", tmpdir != NULL ? tmpdir : "/tmp");
+    if (mkdtemp(root) == NULL) {
+        perror("mkdtemp");
+        return 1;
+    }
+    core_set_progname("core_test");
+
+    test_cache_revalidates();
+    test_cache_evicts_least_recent();
+    test_batch_overflow_streams();
+
+    nftw(root, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+#define _DEFAULT_SOURCE
+
+#include "explore.h"
+
+static const struct core_tool tool = {
+    .name = "explore",
+    .version = CORE_VERSION,
+    .usage =
+        "usage: explore [OPTION]... FILENAME [DIRECTORY]...\n"
+        "\nSearch for a file by name in the given directory (or directories)\n"
+        "\nOptions:\n"
+        "    -v, --verbose                : print more detailed search info\n"
+        "    -r, --recursive              : recursively search the given directory (or directories)\n"
+        "    -o OUTFILE, --outfile OUTFILE: write the search results to the specified file\n"
+        "    -l CODE, --lookup CODE       : determine the meaning of a non-zero status code and exit\n"
+        "    -h, --help                   : show this message and exit\n"
+        "    -V, --version                : show the program version and exit\n"
+        "\nPositionals:\n"
+        "    FILENAME    : the filename to search for\n"
+        "    DIRECTORY...: the directory (or directories) to search in\n"
+        "\nCopyright (c) 2026 Addison Kline (GitHub: @addisonkline)\n",
+};
+
+int lookup_exit_code(
+    const char* exit_code
+) {
+    int code = atoi(exit_code);
+    const char* name = core_error_name(code);
+    if (code == 0 || name == NULL) {
+        return core_error(ERROR_INVALID_LOOKUP_CODE, "invalid exit code: %s", exit_code);
+    }
+
+    core_out_printf(&core_stdout, "%i: %s\n%s\n", code, name, core_error_describe(code));
+    return 0;
+}
+
+void write_find_to_file(
+    struct core_out* out,
+    const char* dir_path,
+    const char* filename
+) {
+    // dir_path/filename
+    core_out_str(out, dir_path);
+    core_out_char(out, '/');
+    core_out_str(out, filename);
+    core_out_char(out, '\n');
+}
+
+static void report_find(
+    const char* dir_path,
+    const char* filename,
+    struct core_out* outfile,
+    const char* outfile_path,
+    int verbose
+) {
+    if (verbose) core_out_str(&core_stdout, "[FIND]\n");
+    core_out_str(&core_stdout, "found ");
+    core_out_str(&core_stdout, filename);
+    core_out_str(&core_stdout, " in ");
+    core_out_str(&core_stdout, dir_path);
+    core_out_char(&core_stdout, '\n');
+    if (verbose) core_out_str(&core_stdout, "[/FIND]\n");
+    if (outfile != NULL) {
+        write_find_to_file(outfile, dir_path, filename);
+        if (verbose) core_out_printf(&core_stdout, "wrote new entry to %s: %s/%s\n", outfile_path, dir_path, filename);
+    }
+}
+
+struct explore_query {
+    const char* filename;
+    struct core_out* outfile;
+    const char* outfile_path;
+    int verbose;
+};
+
+static void enter_directory(
+    struct core_walk* walk,
+    int dir_fd,
+    const char* dir_path
+) {
+    const struct explore_query* query = walk->ctx;
+    (void)dir_fd;
+
+    if (query->verbose) core_out_printf(&core_stdout, "checking directory: %s\n", dir_path);
+}
+
+static void leave_directory(
+    struct core_walk* walk,
+    const char* dir_path
+) {
+    const struct explore_query* query = walk->ctx;
+    (void)dir_path;
+
+    if (query->verbose) core_out_str(&core_stdout, "===\n");
+}
+
+static int check_entry(
+    struct core_walk* walk,
+    int dir_fd,
+    const char* dir_path,
+    const struct core_dirent* entry
+) {
+    const struct explore_query* query = walk->ctx;
+    (void)dir_fd;
+
+    if (query->verbose) core_out_printf(&core_stdout, "checking %s/%s\n", dir_path, entry->name);
+    if (strcmp(query->filename, entry->name) == 0) {
+        report_find(dir_path, query->filename, query->outfile, query->outfile_path, query->verbose);
+    }
+
+    return 0;
+}
+
+int check_directory(
+    int parent_fd,
+    const char* name,
+    const char* dir_path,
+    const char* filename,
+    struct core_out* outfile,
+    const char* outfile_path,
+    int verbose,
+    int recursive
+) {
+    struct explore_query query = {
+        .filename = filename,
+        .outfile = outfile,
+        .outfile_path = outfile_path,
+        .verbose = verbose,
+    };
+    struct core_walk walk = {
+        .recursive = recursive,
+        .ctx = &query,
+        .visit = check_entry,
+        .enter = enter_directory,
+        .leave = leave_directory,
+    };
+
+    return core_walk_dir(&walk, parent_fd, name, dir_path);
+}
+
+int explore_main(int argc, char* argv[]) {
+    int verbose = 0;
+    int recursive = 0;
+    char* filename;
+    char* outfile = NULL;
+
+    core_tool_init(&tool);
+
+    static struct option long_options[] = {
+        { "verbose",   no_argument,       0, 'v' },
+        { "recursive", no_argument,       0, 'r' },
+        { "help",      no_argument,       0, 'h' },
+        { "version",   no_argument,       0, 'V' },
+        { "lookup",    required_argument, 0, 'l' },
+        { "outfile",   required_argument, 0, 'o' },
+        { 0,           0,                 0, 0   }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "vrhVl:o:", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = 1;
+                break;
+            case 'r':
+                recursive = 1;
+                break;
+            case 'o':
+                outfile = optarg;
+                break;
+            case 'l':
+                return core_finish(lookup_exit_code(optarg));
+            default:
+                return core_finish(core_args_default(&tool, opt));
+        }
+    }
+
+    // extract filename
+    if (core_args_require(argc, "filename") != 0) return core_finish(ERROR_MISSING_ARGUMENT);
+    filename = argv[optind];
+    optind++;
+
+    if (verbose) {
+        core_out_printf(&core_stdout, "verbose = %i\n", verbose);
+        core_out_printf(&core_stdout, "recursive = %i\n", recursive);
+        core_out_printf(&core_stdout, "outfile = %s\n", outfile != NULL ? outfile : "(null)");
+        core_out_printf(&core_stdout, "filename = %s\n", filename);
+        core_out_str(&core_stdout, "=====\n");
+    }
+
+    // extract directories
+    if (core_args_require(argc, "directory") != 0) return core_finish(ERROR_MISSING_ARGUMENT);
+
+    struct core_out out;
+    struct core_out* out_p = NULL;
+    if (outfile != NULL) {
+        if (core_out_open(&out, outfile, 1) != 0) return core_finish(ERROR_FILE_OPEN);
+        out_p = &out;
+    }
+
+    int status = 0;
+    for (int i = optind; i < argc; i++) {
+        int ret = check_directory(AT_FDCWD, argv[i], argv[i], filename, out_p, outfile, verbose, recursive);
+        if (ret != 0) status = ret;
+    }
+
+    if (out_p != NULL && core_out_close(out_p) != 0 && status == 0) {
+        status = core_error(ERROR_FWRITE, "failed to write %s", outfile);
+    }
+
+    return core_finish(status);
+}
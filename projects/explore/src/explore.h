@@ -4,26 +4,14 @@
 #include <getopt.h>
 #include <sys/types.h>
 #include <string.h>
-#include <dirent.h>
+#include <fcntl.h>
 
-#define VERSION "1.0.0"
+#include "core.h"
 
-#define ILLEGAL_OPTION 2
-#define DIRECTORY_OPEN_FAILURE 3
-#define DIRECTORY_CLOSE_FAILURE 4
-#define NO_FILENAME_GIVEN 5
-#define NO_DIRECTORY_GIVEN 6
-#define INVALID_LOOKUP_CODE 7
-#define OUTFILE_OPEN_FAILURE 8
+int lookup_exit_code(const char*);
 
-#define PATH_MAX_LEN 1024
+void write_find_to_file(struct core_out*, const char*, const char*);
 
-void print_usage(void);
+int check_directory(int, const char*, const char*, const char*, struct core_out*, const char*, int, int);
 
-void lookup_exit_code(const char*);
-
-void write_find_to_file(const char*, const char*, const char*, int);
-
-void check_directory(const char*, const char*, const char*, int, int);
-
-int main(int, char**);
+int explore_main(int, char**);
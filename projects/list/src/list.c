@@ -0,0 +1,170 @@
+#define _DEFAULT_SOURCE
+
+#include "list.h"
+
+static const struct core_tool tool = {
+    .name = "list",
+    .version = CORE_VERSION,
+    .usage =
+        "usage: list [OPTION]... DIRECTORY...\n"
+        "\nList the contents of a given directory (or directories)\n"
+        "\nOptions:\n"
+        "    -i, --ino                 print each directory entry's serial number\n"
+        "    -f, --files               read each file and print basic information\n"
+        "    -v, --verbose             print more detailed progress of this program while running\n"
+        "    -h, --help                print this message and exit\n"
+        "    -V, --version             print the program version and exit\n"
+        "\nPositionals:\n"
+        "    DIRECTORY...              the directory (or directories) to look through\n"
+        "\nCopyright (c) 2026 Addison Kline (GitHub: @addisonkline)\n",
+};
+
+int read_file(
+    int dir_fd,
+    const char* name,
+    const char* file_path,
+    int verbose
+) {
+    int fd;
+    ssize_t ret;
+    unsigned char buffer[5];
+
+    (void)verbose;
+
+    // open relative to the directory being listed; no path building needed
+    fd = openat(dir_fd, name, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return core_error(ERROR_FILE_OPEN, "failed to open file %s", file_path);
+    }
+
+    // magic (4 bytes) + class (1 byte) in a single read
+    ret = read(fd, buffer, sizeof(buffer));
+    close(fd);
+
+    if (ret == 0) {
+        core_out_str(&core_stdout, "(empty); ");
+        return 0;
+    }
+    if (ret < 4) {
+        return core_error(ERROR_FREAD, "failure while reading file %s: %zd", file_path, ret);
+    }
+
+    core_out_printf(&core_stdout, "ELF magic %#04x%02x%02x%02x; ", buffer[0], buffer[1], buffer[2], buffer[3]);
+
+    if (ret < 5) {
+        return core_error(ERROR_FREAD, "failure while reading file %s: %zd", file_path, ret - 4);
+    }
+
+    core_out_printf(&core_stdout, "class %#04x; ", buffer[4]);
+
+    return 0;
+}
+
+int read_directory(
+    const char* dir_path,
+    int ino,
+    int files,
+    int verbose
+) {
+    struct core_dir dir;
+    struct core_dirent entry;
+    int status = 0;
+
+    if (core_dir_open(&dir, dir_path, 0) != 0) return ERROR_DIR_OPEN;
+
+    core_out_str(&core_stdout, dir_path);
+    core_out_char(&core_stdout, '\n');
+    while (core_dir_next(&dir, &entry)) {
+        const char* entry_name = entry.name;
+        unsigned char entry_type = entry.type;
+        char entry_type_char;
+
+        switch (entry_type) {
+            case DT_REG:
+                entry_type_char = 'F';
+                break;
+            case DT_DIR:
+                entry_type_char = 'D';
+                break;
+            default:
+                entry_type_char = '?';
+        }
+
+        core_out_str(&core_stdout, "> ");
+        core_out_char(&core_stdout, entry_type_char);
+        core_out_char(&core_stdout, ' ');
+        core_out_str(&core_stdout, entry_name);
+        core_out_str(&core_stdout, "; ");
+        if (ino) {
+            core_out_str(&core_stdout, "serial ");
+            core_out_u64(&core_stdout, entry.ino);
+            core_out_str(&core_stdout, "; ");
+        }
+        if (files && entry_type == DT_REG) {
+            char file_path[CORE_PATH_MAX];
+            if (core_path_join(file_path, sizeof(file_path), dir_path, entry_name) != 0) {
+                status = ERROR_PATH_TOO_LONG;
+            } else {
+                int ret = read_file(core_dir_fd(&dir), entry_name, file_path, verbose);
+                if (ret != 0) status = ret;
+            }
+        }
+        core_out_char(&core_stdout, '\n');
+    }
+
+    if (core_dir_close(&dir) != 0) status = ERROR_DIR_CLOSE;
+
+    return status;
+}
+
+int list_main(int argc, char* argv[])
+{
+    int ino = 0;
+    int files = 0;
+    int verbose = 0;
+
+    core_tool_init(&tool);
+
+    static struct option longopts[] = {
+        { "ino",            no_argument, 0, 'i' },
+        { "files",          no_argument, 0, 'f' },
+        { "verbose",        no_argument, 0, 'v' },
+        { "help",           no_argument, 0, 'h' },
+        { "version",        no_argument, 0, 'V' },
+        { 0,                0,           0,  0  }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "ifvhV", longopts, NULL)) != -1) {
+        switch (opt) {
+            case 'i':
+                ino = 1;
+                break;
+            case 'f':
+                files = 1;
+                break;
+            case 'v':
+                verbose = 1;
+                break;
+            default:
+                return core_finish(core_args_default(&tool, opt));
+        }
+    }
+
+    if (core_args_require(argc, "directories") != 0) return core_finish(ERROR_MISSING_ARGUMENT);
+
+    if (verbose) {
+        core_out_str(&core_stdout, "[main] verbose output enabled\n");
+        core_out_printf(&core_stdout, "[main] ino = %i\n", ino);
+        core_out_printf(&core_stdout, "[main] files = %i\n", files);
+    }
+
+    int status = 0;
+    for (int i = optind; i < argc; i++) {
+        if (verbose) core_out_printf(&core_stdout, "[main] reading directory %s\n", argv[i]);
+        int ret = read_directory(argv[i], ino, files, verbose);
+        if (ret != 0) status = ret;
+    }
+
+    return core_finish(status);
+}
@@ -0,0 +1,219 @@
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "search.h"
+
+static const char* ignore_files[] = { ".gitignore", ".ignore" };
+
+// turns each line of data into a rule in place; data must be NUL-terminated
+static int parse_rules(
+    struct search_ignore* ignore
+) {
+    size_t cap = 0;
+
+    for (char* line = ignore->data; line != NULL && *line != '\0';) {
+        char* next = strchr(line, '\n');
+        if (next != NULL) *next++ = '\0';
+
+        size_t len = strlen(line);
+        while (len > 0 && (line[len - 1] == '\r' || (line[len - 1] == ' ' && (len < 2 || line[len - 2] != '\\')))) {
+            line[--len] = '\0';
+        }
+
+        if (len > 0 && line[0] != '#') {
+            struct search_ignore_rule rule = { 0 };
+
+            if (line[0] == '!') {
+                rule.negate = 1;
+                line++;
+                len--;
+            }
+            if (len > 0 && line[len - 1] == '/') {
+                rule.dir_only = 1;
+                line[--len] = '\0';
+            }
+            if (strncmp(line, "**/", 3) == 0) {
+                line += 3;
+                rule.any_depth = strchr(line, '/') != NULL;
+            }
+            if (rule.any_depth) {
+                rule.anchored = 1;
+            } else if (line[0] == '/') {
+                rule.anchored = 1;
+                line++;
+            } else if (strchr(line, '/') != NULL) {
+                rule.anchored = 1;
+            }
+            rule.pattern = line;
+
+            if (*line != '\0') {
+                if (ignore->rules_len == cap) {
+                    cap = cap ? cap * 2 : 16;
+                    struct search_ignore_rule* grown = realloc(ignore->rules, cap * sizeof(*grown));
+                    if (grown == NULL) return -1;
+                    ignore->rules = grown;
+                }
+                ignore->rules[ignore->rules_len++] = rule;
+            }
+        }
+
+        line = next;
+    }
+
+    return 0;
+}
+
+static int load_ignore_file(
+    struct search_query* query,
+    int dir_fd,
+    const char* dir_path,
+    const char* name
+) {
+    int fd = openat(dir_fd, name, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size > SEARCH_IGNORE_MAX_SIZE) {
+        close(fd);
+        return 0;
+    }
+
+    if (query->ignores_len == query->ignores_cap) {
+        size_t cap = query->ignores_cap ? query->ignores_cap * 2 : 8;
+        struct search_ignore* grown = realloc(query->ignores, cap * sizeof(*grown));
+        if (grown == NULL) {
+            close(fd);
+            return core_error(ERROR_MALLOC, "malloc failed");
+        }
+        query->ignores = grown;
+        query->ignores_cap = cap;
+    }
+
+    struct search_ignore* ignore = &query->ignores[query->ignores_len];
+    memset(ignore, 0, sizeof(*ignore));
+    ignore->depth = query->walk_depth;
+    ignore->base_len = strlen(dir_path);
+    ignore->data = malloc((size_t)st.st_size + 1);
+    if (ignore->data == NULL) {
+        close(fd);
+        return core_error(ERROR_MALLOC, "malloc failed");
+    }
+
+    ssize_t nread = read(fd, ignore->data, (size_t)st.st_size);
+    close(fd);
+    if (nread < 0) {
+        free(ignore->data);
+        return core_error(ERROR_FREAD, "failure while reading %s/%s", dir_path, name);
+    }
+    ignore->data[nread] = '\0';
+
+    if (parse_rules(ignore) != 0) {
+        free(ignore->rules);
+        free(ignore->data);
+        return core_error(ERROR_MALLOC, "malloc failed");
+    }
+
+    query->ignores_len++;
+    return 0;
+}
+
+int search_ignore_push(
+    struct search_query* query,
+    int dir_fd,
+    const char* dir_path
+) {
+    int status = 0;
+
+    query->walk_depth++;
+    if (!query->use_ignore) return 0;
+
+    for (size_t i = 0; i < sizeof(ignore_files) / sizeof(ignore_files[0]); i++) {
+        int ret = load_ignore_file(query, dir_fd, dir_path, ignore_files[i]);
+        if (ret != 0) status = ret;
+    }
+
+    return status;
+}
+
+void search_ignore_pop(
+    struct search_query* query
+) {
+    while (query->ignores_len > 0 && query->ignores[query->ignores_len - 1].depth == query->walk_depth) {
+        struct search_ignore* ignore = &query->ignores[--query->ignores_len];
+        free(ignore->rules);
+        free(ignore->data);
+    }
+    query->walk_depth--;
+}
+
+void search_ignore_free(
+    struct search_query* query
+) {
+    while (query->ignores_len > 0) {
+        struct search_ignore* ignore = &query->ignores[--query->ignores_len];
+        free(ignore->rules);
+        free(ignore->data);
+    }
+    free(query->ignores);
+    query->ignores = NULL;
+    query->ignores_cap = 0;
+}
+
+static int match_anchored(
+    const struct search_ignore_rule* rule,
+    const char* rel_path
+) {
+    for (const char* start = rel_path; start != NULL;) {
+        if (fnmatch(rule->pattern, start, FNM_PATHNAME) == 0) return 1;
+        if (!rule->any_depth) return 0;
+
+        // retry from the next directory boundary
+        start = strchr(start, '/');
+        if (start != NULL) start++;
+    }
+    return 0;
+}
+
+int search_ignore_match(
+    const struct search_query* query,
+    const char* dir_path,
+    const char* name,
+    int is_dir
+) {
+    int ignored = 0;
+
+    // later (deeper) files and later lines win, as with git
+    for (size_t i = 0; i < query->ignores_len; i++) {
+        const struct search_ignore* ignore = &query->ignores[i];
+        char rel[CORE_PATH_MAX];
+        const char* rel_path = NULL;
+
+        for (size_t j = 0; j < ignore->rules_len; j++) {
+            const struct search_ignore_rule* rule = &ignore->rules[j];
+            if (rule->dir_only && !is_dir) continue;
+            if (rule->negate != ignored) continue;
+
+            int matched;
+            if (rule->anchored) {
+                // anchored rules match the path relative to the ignore file
+                if (rel_path == NULL) {
+                    const char* rel_dir = dir_path + ignore->base_len;
+                    while (*rel_dir == '/') rel_dir++;
+                    if (*rel_dir == '\0') rel_path = name;
+                    else if (snprintf(rel, sizeof(rel), "%s/%s", rel_dir, name) < (int)sizeof(rel)) rel_path = rel;
+                    else continue;
+                }
+                matched = match_anchored(rule, rel_path);
+            } else {
+                matched = fnmatch(rule->pattern, name, 0) == 0;
+            }
+            if (matched) ignored = !rule->negate;
+        }
+    }
+
+    return ignored;
+}
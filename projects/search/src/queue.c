@@ -0,0 +1,75 @@
+#include "search.h"
+
+int search_queue_init(
+    struct search_queue* queue,
+    size_t capacity
+) {
+    queue->items = malloc(sizeof(*queue->items) * capacity);
+    if (queue->items == NULL) return core_error(ERROR_MALLOC, "malloc failed");
+
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->len = 0;
+    queue->closed = 0;
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->not_empty, NULL);
+    pthread_cond_init(&queue->not_full, NULL);
+    return 0;
+}
+
+void search_queue_destroy(
+    struct search_queue* queue
+) {
+    pthread_cond_destroy(&queue->not_full);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->items);
+    queue->items = NULL;
+}
+
+void search_queue_push(
+    struct search_queue* queue,
+    char* item
+) {
+    pthread_mutex_lock(&queue->lock);
+
+    // block the producer while workers catch up, keeping memory bounded
+    while (queue->len == queue->capacity) {
+        pthread_cond_wait(&queue->not_full, &queue->lock);
+    }
+    queue->items[(queue->head + queue->len) % queue->capacity] = item;
+    queue->len++;
+
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+char* search_queue_pop(
+    struct search_queue* queue
+) {
+    char* item = NULL;
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->len == 0 && !queue->closed) {
+        pthread_cond_wait(&queue->not_empty, &queue->lock);
+    }
+    if (queue->len > 0) {
+        item = queue->items[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->len--;
+        pthread_cond_signal(&queue->not_full);
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    // NULL once the queue is closed and drained
+    return item;
+}
+
+void search_queue_close(
+    struct search_queue* queue
+) {
+    pthread_mutex_lock(&queue->lock);
+    queue->closed = 1;
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+}
@@ -0,0 +1,526 @@
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+
+#include "search.h"
+
+static const struct core_tool tool = {
+    .name = "search",
+    .version = CORE_VERSION,
+    .usage =
+        "usage: search [OPTION]... LITERAL [FILE|DIRECTORY]...\n"
+        "\nSearch for a string literal in the given file(s); directories are searched recursively\n"
+        "and gzip-compressed files are searched as their decompressed contents\n"
+        "\nOptions:\n"
+        "    -n, --line-numbers: include line numbers for each literal found\n"
+        "    -v, --verbose: print more detailed search info\n"
+        "    -h, --help: show this message and exit\n"
+        "    -V, --version: show the program version and exit\n"
+        "    -o OUTFILE, --outfile OUTFILE: write the search results to the specified file\n"
+        "    -g GLOB, --glob GLOB: only search files whose name matches GLOB (repeatable)\n"
+        "    -x GLOB, --exclude GLOB: skip files and directories whose name matches GLOB (repeatable)\n"
+        "    -j JOBS, --jobs JOBS: scan files with JOBS worker threads (default 1); with more than\n"
+        "        one, files are reported in completion order\n"
+        "    -a, --binary: also scan files that look binary (a NUL byte in the first block)\n"
+        "    -I, --no-ignore: don't prune directories using .gitignore/.ignore files\n"
+        "\nPositionals:\n"
+        "    LITERAL: the string literal to search for\n"
+        "    FILE...: the file(s) or directories to search\n",
+};
+
+void write_occurrence_to_file(
+    struct core_out* out,
+    const char* file,
+    int line_num,
+    int col_num
+) {
+    // file:line:col
+    core_out_str(out, file);
+    core_out_char(out, ':');
+    core_out_i64(out, line_num);
+    core_out_char(out, ':');
+    core_out_i64(out, col_num);
+    core_out_char(out, '\n');
+}
+
+int count_pattern_in_line(
+    const char* line,
+    size_t len_line,
+    const char* pattern,
+    const char* file,
+    struct core_out* out,
+    struct core_out* outfile,
+    int line_num,
+    int verbose
+) {
+    size_t len_pattern = strlen(pattern);
+
+    if (len_pattern > len_line) return 0;
+
+    size_t idx_line = 0;
+    size_t idx_pattern = 0;
+    size_t len_equal = 0;
+    int count = 0;
+
+    while (idx_line < len_line) {
+        if (line[idx_line] == pattern[idx_pattern]) {
+            len_equal++;
+            idx_pattern++;
+
+            if (len_equal == len_pattern) {
+                if (verbose) {
+                    core_out_printf(out, "> > found occurrence at column %zu\n", idx_line);
+                }
+                if (outfile != NULL) {
+                    write_occurrence_to_file(outfile, file, line_num, (int)idx_line);
+                }
+                count++;
+                len_equal = 0;
+            }
+        }
+        else {
+            idx_pattern = 0;
+            len_equal = 0;
+        }
+
+        idx_line++;
+    }
+
+    return count;
+}
+
+static void scan_line(
+    const struct search_query* query,
+    const char* file,
+    struct core_out* out,
+    struct core_out* outfile,
+    const char* line,
+    size_t len,
+    int* line_num,
+    int* count
+) {
+    int line_count = count_pattern_in_line(line, len, query->pattern, file, out, outfile, *line_num, query->verbose);
+    (*line_num)++;
+    *count += line_count;
+    if ((line_count > 0 && query->line_numbers) || query->verbose) {
+        core_out_str(out, "> found ");
+        core_out_i64(out, line_count);
+        core_out_str(out, " occurrences in line ");
+        core_out_i64(out, *line_num);
+        core_out_char(out, '\n');
+    }
+}
+
+int count_pattern_in_file(
+    const struct search_query* query,
+    struct search_scanner* scanner,
+    const char* file,
+    struct core_out* out,
+    struct core_out* outfile,
+    int* total
+) {
+    struct search_source* source = &scanner->source;
+    char* block = scanner->block;
+    ssize_t nread;
+
+    if (search_source_open(source, file) != 0) {
+        return core_error(ERROR_FILE_OPEN, "failed to open file %s", file);
+    }
+
+    nread = search_source_read(source, block, sizeof(scanner->block));
+#ifdef SEARCH_HAVE_ZLIB
+    // gzip header: scan the decompressed stream instead, without touching disk
+    if (nread > 0 && search_source_is_gzip(block, (size_t)nread)) {
+        if (query->verbose) core_out_str(out, "> decompressing gzip stream\n");
+        if (search_source_inflate(source, block, (size_t)nread) != 0) {
+            search_source_close(source);
+            return core_error(ERROR_FREAD, "failed to decompress file %s", file);
+        }
+        nread = search_source_read(source, block, sizeof(scanner->block));
+    }
+#endif
+
+    // a NUL in the first block marks the file as binary; skip it before scanning
+    if (!query->scan_binary && nread > 0 && memchr(block, '\0', (size_t)nread) != NULL) {
+        search_source_close(source);
+        *total = SEARCH_BINARY_SKIPPED;
+        return 0;
+    }
+
+    int count = 0;
+    int line_num = 0;
+    size_t carry = 0;
+    while (nread > 0) {
+        const char* p = block;
+        const char* end = block + nread;
+
+        while (p < end) {
+            const char* newline = memchr(p, '\n', (size_t)(end - p));
+            size_t len = newline != NULL ? (size_t)(newline + 1 - p) : (size_t)(end - p);
+
+            if (newline != NULL && carry == 0) {
+                // whole line inside the block: scan it in place
+                scan_line(query, file, out, outfile, p, len, &line_num, &count);
+            } else {
+                // line spans blocks: collect it in the scanner's line buffer
+                if (carry + len > scanner->line_cap) {
+                    size_t cap = scanner->line_cap ? scanner->line_cap : 256;
+                    while (cap < carry + len) cap *= 2;
+                    char* grown = realloc(scanner->line, cap);
+                    if (grown == NULL) {
+                        search_source_close(source);
+                        return core_error(ERROR_MALLOC, "malloc failed");
+                    }
+                    scanner->line = grown;
+                    scanner->line_cap = cap;
+                }
+                memcpy(scanner->line + carry, p, len);
+                carry += len;
+
+                if (newline != NULL) {
+                    scan_line(query, file, out, outfile, scanner->line, carry, &line_num, &count);
+                    carry = 0;
+                }
+            }
+            p += len;
+        }
+
+        nread = search_source_read(source, block, sizeof(scanner->block));
+    }
+
+    search_source_close(source);
+    if (nread < 0) {
+        return core_error(ERROR_FREAD, "failure while reading file %s", file);
+    }
+
+    // last line without a trailing newline
+    if (carry > 0) scan_line(query, file, out, outfile, scanner->line, carry, &line_num, &count);
+
+    *total = count;
+    return 0;
+}
+
+static void set_status(
+    struct search_query* query,
+    int status
+) {
+    pthread_mutex_lock(&query->status_lock);
+    query->status = status;
+    pthread_mutex_unlock(&query->status_lock);
+}
+
+static void scan_file(
+    struct search_query* query,
+    struct search_scanner* scanner,
+    struct core_out* out,
+    struct core_out* outfile,
+    const char* file
+) {
+    int result = 0;
+
+    core_out_str(out, "reading file ");
+    core_out_str(out, file);
+    core_out_str(out, "...\n");
+
+    int ret = count_pattern_in_file(query, scanner, file, out, outfile, &result);
+    if (ret != 0) {
+        set_status(query, ret);
+        return;
+    }
+    if (result == SEARCH_BINARY_SKIPPED) {
+        core_out_str(out, "> skipped binary file\n");
+        return;
+    }
+
+    core_out_str(out, "> TOTAL: ");
+    core_out_i64(out, result);
+    core_out_str(out, " occurrences\n");
+}
+
+static void* scan_worker(
+    void* arg
+) {
+    struct search_query* query = arg;
+    struct core_out* out = malloc(sizeof(*out));
+    struct core_out* outfile = NULL;
+    struct search_scanner* scanner = malloc(sizeof(*scanner));
+    char* file;
+
+    if (out == NULL || scanner == NULL || (query->outfile_fd != -1 && (outfile = malloc(sizeof(*outfile))) == NULL)) {
+        set_status(query, core_error(ERROR_MALLOC, "malloc failed"));
+        free(scanner);
+        free(out);
+        // keep draining so the walker never blocks on a full queue
+        while ((file = search_queue_pop(&query->queue)) != NULL) free(file);
+        return NULL;
+    }
+
+    scanner->line = NULL;
+    scanner->line_cap = 0;
+
+    // private buffers under a shared lock; batched per file so reports never interleave
+    core_out_init(out, core_stdout.fd);
+    out->lock = &query->out_lock;
+    if (outfile != NULL) {
+        core_out_init(outfile, query->outfile_fd);
+        outfile->lock = &query->out_lock;
+    }
+
+    while ((file = search_queue_pop(&query->queue)) != NULL) {
+        if (query->batch) {
+            core_out_begin(out);
+            if (outfile != NULL) core_out_begin(outfile);
+        }
+        scan_file(query, scanner, out, outfile, file);
+        if (query->batch) {
+            core_out_end(out);
+            if (outfile != NULL) core_out_end(outfile);
+        }
+        free(file);
+    }
+
+    if (core_out_close(out) != 0 || (outfile != NULL && core_out_close(outfile) != 0)) {
+        set_status(query, core_error(ERROR_FWRITE, "failed to write output"));
+    }
+    free(scanner->line);
+    free(scanner);
+    free(outfile);
+    free(out);
+    return NULL;
+}
+
+static int matches_any(
+    const char** globs,
+    size_t globs_len,
+    const char* name
+) {
+    for (size_t i = 0; i < globs_len; i++) {
+        if (fnmatch(globs[i], name, 0) == 0) return 1;
+    }
+    return 0;
+}
+
+static void enter_directory(
+    struct core_walk* walk,
+    int dir_fd,
+    const char* dir_path
+) {
+    struct search_query* query = walk->ctx;
+
+    int ret = search_ignore_push(query, dir_fd, dir_path);
+    if (ret != 0) set_status(query, ret);
+}
+
+static void leave_directory(
+    struct core_walk* walk,
+    const char* dir_path
+) {
+    (void)dir_path;
+    search_ignore_pop(walk->ctx);
+}
+
+static int descend_directory(
+    struct core_walk* walk,
+    const char* dir_path,
+    const struct core_dirent* entry
+) {
+    const struct search_query* query = walk->ctx;
+
+    if (matches_any(query->excludes, query->excludes_len, entry->name)) return 0;
+    if (query->use_ignore) {
+        if (strcmp(entry->name, ".git") == 0) return 0;
+        if (search_ignore_match(query, dir_path, entry->name, 1)) return 0;
+    }
+    return 1;
+}
+
+static int queue_entry(
+    struct core_walk* walk,
+    int dir_fd,
+    const char* dir_path,
+    const struct core_dirent* entry
+) {
+    struct search_query* query = walk->ctx;
+    char path[CORE_PATH_MAX];
+    (void)dir_fd;
+
+    if (entry->type != DT_REG) return 0;
+    if (query->globs_len > 0 && !matches_any(query->globs, query->globs_len, entry->name)) return 0;
+    if (matches_any(query->excludes, query->excludes_len, entry->name)) return 0;
+    if (query->use_ignore && search_ignore_match(query, dir_path, entry->name, 0)) return 0;
+
+    if (core_path_join(path, sizeof(path), dir_path, entry->name) != 0) return ERROR_PATH_TOO_LONG;
+
+    char* file = strdup(path);
+    if (file == NULL) return core_error(ERROR_MALLOC, "malloc failed");
+    search_queue_push(&query->queue, file);
+    return 0;
+}
+
+int search_directory(
+    struct search_query* query,
+    const char* dir_path
+) {
+    struct core_walk walk = {
+        .recursive = 1,
+        .ctx = query,
+        .visit = queue_entry,
+        .descend = descend_directory,
+        .enter = enter_directory,
+        .leave = leave_directory,
+    };
+
+    return core_walk_dir(&walk, AT_FDCWD, dir_path, dir_path);
+}
+
+int search_main(int argc, char* argv[])
+{
+    int line_numbers = 0;
+    int verbose = 0;
+    int scan_binary = 0;
+    int use_ignore = 1;
+    long jobs = 1;
+    char* outfile = NULL;
+    char* pattern;
+    char* end;
+
+    core_tool_init(&tool);
+
+    // at most one glob per argument, so argc bounds both lists
+    const char** globs = malloc(sizeof(*globs) * (size_t)argc);
+    const char** excludes = malloc(sizeof(*excludes) * (size_t)argc);
+    size_t globs_len = 0;
+    size_t excludes_len = 0;
+    int status = 0;
+    if (globs == NULL || excludes == NULL) {
+        status = core_error(ERROR_MALLOC, "malloc failed");
+        goto done;
+    }
+
+    static struct option longopts[] = {
+        {"line-number",  no_argument,       0, 'n'},
+        {"verbose", no_argument, 0, 'v'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'V'},
+        {"outfile", required_argument, 0, 'o'},
+        {"glob", required_argument, 0, 'g'},
+        {"exclude", required_argument, 0, 'x'},
+        {"jobs", required_argument, 0, 'j'},
+        {"binary", no_argument, 0, 'a'},
+        {"no-ignore", no_argument, 0, 'I'},
+        {0, 0, 0, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "nvhVo:g:x:j:aI", longopts, NULL)) != -1) {
+        switch (opt) {
+            case 'n': line_numbers = 1; break;
+            case 'v': verbose = 1; break;
+            case 'a': scan_binary = 1; break;
+            case 'I': use_ignore = 0; break;
+            case 'o':
+                outfile = optarg;
+                break;
+            case 'g':
+                globs[globs_len++] = optarg;
+                break;
+            case 'x':
+                excludes[excludes_len++] = optarg;
+                break;
+            case 'j':
+                jobs = strtol(optarg, &end, 10);
+                if (*end != '\0' || jobs < 1 || jobs > SEARCH_MAX_JOBS) {
+                    status = core_error(ERROR_INVALID_OPTION, "invalid number of jobs: %s", optarg);
+                    goto done;
+                }
+                break;
+            default:
+                status = core_args_default(&tool, opt);
+                goto done;
+        }
+    }
+
+    // extract literal (pattern)
+    if ((status = core_args_require(argc, "literal")) != 0) goto done;
+    pattern = argv[optind];
+    optind++;
+
+    if (verbose) {
+        core_out_printf(&core_stdout, "line_numbers = %d\n", line_numbers);
+        core_out_printf(&core_stdout, "verbose = %d\n", verbose);
+        core_out_printf(&core_stdout, "pattern = '%s'\n", pattern);
+        core_out_printf(&core_stdout, "outfile = '%s'\n", outfile != NULL ? outfile : "(null)");
+        core_out_str(&core_stdout, "===\n");
+    }
+    // workers write to the same fd through their own buffers
+    core_out_flush(&core_stdout);
+
+    struct core_out out;
+    if (outfile != NULL && (status = core_out_open(&out, outfile, 1)) != 0) goto done;
+
+    struct search_query query = {
+        .pattern = pattern,
+        .line_numbers = line_numbers,
+        .verbose = verbose,
+        .scan_binary = scan_binary,
+        .use_ignore = use_ignore,
+        .globs = globs,
+        .globs_len = globs_len,
+        .excludes = excludes,
+        .excludes_len = excludes_len,
+        .outfile_fd = outfile != NULL ? out.fd : -1,
+        .batch = jobs > 1,
+        .status = 0,
+    };
+    // recursive: a worker whose stdout and outfile batches both overflow holds it twice
+    pthread_mutexattr_t out_lock_attr;
+    pthread_mutexattr_init(&out_lock_attr);
+    pthread_mutexattr_settype(&out_lock_attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&query.out_lock, &out_lock_attr);
+    pthread_mutexattr_destroy(&out_lock_attr);
+    pthread_mutex_init(&query.status_lock, NULL);
+
+    pthread_t workers[SEARCH_MAX_JOBS];
+    long started = 0;
+    if ((status = search_queue_init(&query.queue, SEARCH_QUEUE_CAPACITY)) == 0) {
+        for (; started < jobs; started++) {
+            if (pthread_create(&workers[started], NULL, scan_worker, &query) != 0) break;
+        }
+        if (started == 0) status = core_error(ERROR_GENERIC, "unable to start worker threads");
+    }
+
+    // walk on this thread while the workers scan what has been found so far
+    for (int i = optind; i < argc && started > 0; i++) {
+        struct stat st;
+        int ret = 0;
+        if (stat(argv[i], &st) == 0 && S_ISDIR(st.st_mode)) {
+            ret = search_directory(&query, argv[i]);
+        } else {
+            char* file = strdup(argv[i]);
+            if (file == NULL) ret = core_error(ERROR_MALLOC, "malloc failed");
+            else search_queue_push(&query.queue, file);
+        }
+        if (ret != 0) set_status(&query, ret);
+    }
+
+    if (started > 0) {
+        search_queue_close(&query.queue);
+        for (long i = 0; i < started; i++) pthread_join(workers[i], NULL);
+        if (query.status != 0) status = query.status;
+    }
+    if (query.queue.items != NULL) search_queue_destroy(&query.queue);
+    search_ignore_free(&query);
+    pthread_mutex_destroy(&query.status_lock);
+    pthread_mutex_destroy(&query.out_lock);
+
+    if (outfile != NULL && core_out_close(&out) != 0 && status == 0) {
+        status = core_error(ERROR_FWRITE, "failed to write %s", outfile);
+    }
+
+done:
+    free(excludes);
+    free(globs);
+    return core_finish(status);
+}
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#ifdef SEARCH_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "core.h"
+
+#define SEARCH_QUEUE_CAPACITY 256
+#define SEARCH_MAX_JOBS 256
+#define SEARCH_BLOCK_SIZE (64 * 1024)
+#define SEARCH_IGNORE_MAX_SIZE (1024 * 1024)
+#define SEARCH_BINARY_SKIPPED -1
+
+// bounded hand-off of discovered file paths from the walker to the workers
+struct search_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    char** items;
+    size_t capacity;
+    size_t head;
+    size_t len;
+    int closed;
+};
+
+// a file being scanned block by block, decompressing gzip streams on the fly
+struct search_source {
+    int fd;
+    int compressed;
+#ifdef SEARCH_HAVE_ZLIB
+    int member_done;
+    int fd_eof;
+    int stream_end;
+    int truncated;
+    z_stream zs;
+    unsigned char in[SEARCH_BLOCK_SIZE];
+#endif
+};
+
+// per-worker scratch reused across files
+struct search_scanner {
+    struct search_source source;
+    char block[SEARCH_BLOCK_SIZE];
+    char* line;
+    size_t line_cap;
+};
+
+struct search_ignore_rule {
+    const char* pattern;
+    int negate;
+    int dir_only;
+    int anchored;
+    // a leading **/ lets an anchored rule start at any directory below the ignore file
+    int any_depth;
+};
+
+// rules from one ignore file, applying to the directory it was found in and below
+struct search_ignore {
+    size_t depth;
+    size_t base_len;
+    char* data;
+    struct search_ignore_rule* rules;
+    size_t rules_len;
+};
+
+struct search_query {
+    const char* pattern;
+    int line_numbers;
+    int verbose;
+    int scan_binary;
+    int use_ignore;
+    const char** globs;
+    size_t globs_len;
+    const char** excludes;
+    size_t excludes_len;
+    struct search_ignore* ignores;
+    size_t ignores_len;
+    size_t ignores_cap;
+    size_t walk_depth;
+    int outfile_fd;
+    // with several workers each file's report is written as one batch
+    int batch;
+    pthread_mutex_t out_lock;
+    struct search_queue queue;
+    pthread_mutex_t status_lock;
+    int status;
+};
+
+int search_queue_init(struct search_queue*, size_t);
+
+void search_queue_destroy(struct search_queue*);
+
+void search_queue_push(struct search_queue*, char*);
+
+char* search_queue_pop(struct search_queue*);
+
+void search_queue_close(struct search_queue*);
+
+int search_source_open(struct search_source*, const char*);
+
+#ifdef SEARCH_HAVE_ZLIB
+int search_source_is_gzip(const char*, size_t);
+
+int search_source_inflate(struct search_source*, const char*, size_t);
+#endif
+
+ssize_t search_source_read(struct search_source*, char*, size_t);
+
+void search_source_close(struct search_source*);
+
+int search_ignore_push(struct search_query*, int, const char*);
+
+void search_ignore_pop(struct search_query*);
+
+void search_ignore_free(struct search_query*);
+
+int search_ignore_match(const struct search_query*, const char*, const char*, int);
+
+void write_occurrence_to_file(struct core_out*, const char*, int, int);
+
+int count_pattern_in_line(const char*, size_t, const char*, const char*, struct core_out*, struct core_out*, int, int);
+
+int count_pattern_in_file(const struct search_query*, struct search_scanner*, const char*, struct core_out*, struct core_out*, int*);
+
+int search_directory(struct search_query*, const char*);
+
+int search_main(int, char**);
@@ -0,0 +1,119 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "search.h"
+
+int search_source_open(
+    struct search_source* source,
+    const char* file
+) {
+    source->fd = open(file, O_RDONLY | O_CLOEXEC);
+    source->compressed = 0;
+    return source->fd == -1 ? -1 : 0;
+}
+
+#ifdef SEARCH_HAVE_ZLIB
+// magic, deflate method and no reserved flag bits (RFC 1952); a file that
+// merely starts with 1f 8b is scanned as-is
+int search_source_is_gzip(
+    const char* data,
+    size_t len
+) {
+    const unsigned char* p = (const unsigned char*)data;
+    return len >= 10 && p[0] == 0x1f && p[1] == 0x8b && p[2] == 8 && (p[3] & 0xe0) == 0;
+}
+
+int search_source_inflate(
+    struct search_source* source,
+    const char* data,
+    size_t len
+) {
+    memset(&source->zs, 0, sizeof(source->zs));
+
+    // 16 + MAX_WBITS: expect a gzip header
+    if (inflateInit2(&source->zs, 16 + MAX_WBITS) != Z_OK) return -1;
+
+    // the bytes already read are the start of the compressed stream
+    memcpy(source->in, data, len);
+    source->zs.next_in = source->in;
+    source->zs.avail_in = (uInt)len;
+    source->compressed = 1;
+    source->member_done = 0;
+    source->fd_eof = 0;
+    source->stream_end = 0;
+    source->truncated = 0;
+    return 0;
+}
+
+static ssize_t read_compressed(
+    struct search_source* source,
+    char* buf,
+    size_t len
+) {
+    z_stream* zs = &source->zs;
+    zs->next_out = (Bytef*)buf;
+    zs->avail_out = (uInt)len;
+
+    while (zs->avail_out == len && !source->stream_end) {
+        if (zs->avail_in == 0 && !source->fd_eof) {
+            ssize_t nread = read(source->fd, source->in, sizeof(source->in));
+            if (nread < 0 && errno == EINTR) continue;
+            if (nread < 0) return -1;
+            if (nread == 0) source->fd_eof = 1;
+            zs->next_in = source->in;
+            zs->avail_in = (uInt)nread;
+        }
+
+        int ret = inflate(zs, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            // rotated logs are often several gzip members back to back
+            if (inflateReset(zs) != Z_OK) return -1;
+            source->member_done = 1;
+        } else if (ret == Z_BUF_ERROR && source->fd_eof) {
+            // out of input: a clean end between members, truncated inside one
+            // (inflateReset zeroes total_in, so it counts the current member only)
+            source->stream_end = 1;
+            source->truncated = zs->total_in > 0;
+        } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+            // like gzip, ignore trailing garbage after a complete member
+            if (!source->member_done || zs->total_out != 0) return -1;
+            source->stream_end = 1;
+        }
+    }
+
+    // hand out what was decompressed before reporting the truncation
+    size_t produced = len - zs->avail_out;
+    if (produced == 0 && source->truncated) return -1;
+    return (ssize_t)produced;
+}
+#endif
+
+ssize_t search_source_read(
+    struct search_source* source,
+    char* buf,
+    size_t len
+) {
+#ifdef SEARCH_HAVE_ZLIB
+    if (source->compressed) return read_compressed(source, buf, len);
+#endif
+
+    for (;;) {
+        ssize_t nread = read(source->fd, buf, len);
+        if (nread < 0 && errno == EINTR) continue;
+        return nread;
+    }
+}
+
+void search_source_close(
+    struct search_source* source
+) {
+#ifdef SEARCH_HAVE_ZLIB
+    if (source->compressed) inflateEnd(&source->zs);
+#endif
+    source->compressed = 0;
+    if (source->fd != -1) close(source->fd);
+    source->fd = -1;
+}
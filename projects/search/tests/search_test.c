@@ -0,0 +1,330 @@
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <ftw.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "search.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+static char root[CORE_PATH_MAX];
+
+static void make_path(
+    char* path,
+    const char* rel
+) {
+    CHECK(core_path_join(path, CORE_PATH_MAX, root, rel) == 0);
+}
+
+static void write_fixture(
+    const char* rel,
+    const char* data,
+    size_t len
+) {
+    char path[CORE_PATH_MAX];
+    make_path(path, rel);
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    CHECK(fd != -1);
+    if (fd == -1) return;
+    CHECK(write(fd, data, len) == (ssize_t)len);
+    close(fd);
+}
+
+static void write_text(
+    const char* rel,
+    const char* text
+) {
+    write_fixture(rel, text, strlen(text));
+}
+
+static void make_dir(
+    const char* rel
+) {
+    char path[CORE_PATH_MAX];
+    make_path(path, rel);
+    CHECK(mkdir(path, 0755) == 0);
+}
+
+static int remove_entry(
+    const char* path,
+    const struct stat* st,
+    int type,
+    struct FTW* ftw
+) {
+    (void)st;
+    (void)type;
+    (void)ftw;
+    return remove(path) == -1 ? -1 : 0;
+}
+
+// scans rel and returns count_pattern_in_file's status; occurrences go to results
+static int scan(
+    const char* rel,
+    int* total,
+    char* results,
+    size_t results_size
+) {
+    static struct search_scanner scanner;
+    struct search_query query = { .pattern = "needle" };
+    char path[CORE_PATH_MAX];
+    char out_path[CORE_PATH_MAX];
+    struct core_out out;
+    struct core_out outfile;
+
+    make_path(path, rel);
+    make_path(out_path, "occurrences.out");
+
+    core_out_init(&out, open("/dev/null", O_WRONLY | O_CLOEXEC));
+    out.owns_fd = 1;
+    if (core_out_open(&outfile, out_path, 0) != 0) return -1;
+
+    int ret = count_pattern_in_file(&query, &scanner, path, &out, &outfile, total);
+    core_out_close(&out);
+    core_out_close(&outfile);
+
+    int fd = open(out_path, O_RDONLY | O_CLOEXEC);
+    ssize_t nread = fd == -1 ? -1 : read(fd, results, results_size - 1);
+    results[nread > 0 ? nread : 0] = '\0';
+    if (fd != -1) close(fd);
+    unlink(out_path);
+
+    free(scanner.line);
+    scanner.line = NULL;
+    scanner.line_cap = 0;
+    return ret;
+}
+
+static void test_final_line_without_newline(void) {
+    char results[256];
+    char expected[CORE_PATH_MAX + 32];
+    int total = 0;
+
+    write_text("tail.txt", "one\ntwo needle");
+    CHECK(scan("tail.txt", &total, results, sizeof(results)) == 0);
+    CHECK(total == 1);
+
+    make_path(expected, "tail.txt");
+    strcat(expected, ":1:9\n");
+    CHECK(strcmp(results, expected) == 0);
+}
+
+static void test_line_longer_than_block(void) {
+    size_t len = SEARCH_BLOCK_SIZE * 2 + 100;
+    size_t straddle = SEARCH_BLOCK_SIZE - 3;
+    char* data = malloc(len + 16);
+    char results[3 * CORE_PATH_MAX + 64];
+    char expected[3 * CORE_PATH_MAX + 64];
+    char path[CORE_PATH_MAX];
+    int total = 0;
+
+    CHECK(data != NULL);
+    if (data == NULL) return;
+
+    // one needle across the first block boundary, one at the end of the line
+    memset(data, 'x', len);
+    memcpy(data + straddle, "needle", 6);
+    memcpy(data + len - 6, "needle", 6);
+    memcpy(data + len, "\nneedle\n", 8);
+    write_fixture("long.txt", data, len + 8);
+    free(data);
+
+    CHECK(scan("long.txt", &total, results, sizeof(results)) == 0);
+    CHECK(total == 3);
+
+    make_path(path, "long.txt");
+    snprintf(expected, sizeof(expected), "%s:0:%zu\n%s:0:%zu\n%s:1:5\n",
+        path, straddle + 5, path, len - 1, path);
+    CHECK(strcmp(results, expected) == 0);
+}
+
+#ifdef SEARCH_HAVE_ZLIB
+// compresses text as one gzip member appended to buf
+static size_t gzip_member(
+    char* buf,
+    size_t size,
+    const char* text
+) {
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) return 0;
+
+    zs.next_in = (Bytef*)text;
+    zs.avail_in = (uInt)strlen(text);
+    zs.next_out = (Bytef*)buf;
+    zs.avail_out = (uInt)size;
+    int ret = deflate(&zs, Z_FINISH);
+    size_t len = size - zs.avail_out;
+    deflateEnd(&zs);
+    return ret == Z_STREAM_END ? len : 0;
+}
+
+static void test_gzip(void) {
+    static char buf[256 * 1024];
+    char results[4096];
+    int total = 0;
+    size_t len;
+
+    // members back to back, the last line without a newline
+    len = gzip_member(buf, sizeof(buf), "a needle\n");
+    len += gzip_member(buf + len, sizeof(buf) - len, "b needle\nneedle");
+    write_fixture("multi.gz", buf, len);
+    CHECK(scan("multi.gz", &total, results, sizeof(results)) == 0);
+    CHECK(total == 3);
+
+    // trailing garbage after a complete member is ignored, as gzip does
+    len = gzip_member(buf, sizeof(buf), "a needle\n");
+    memcpy(buf + len, "garbage\0\0", 9);
+    write_fixture("garbage.gz", buf, len + 9);
+    CHECK(scan("garbage.gz", &total, results, sizeof(results)) == 0);
+    CHECK(total == 1);
+
+    // a member cut short is a read error, not a clean end
+    char* text = malloc(512 * 1024);
+    CHECK(text != NULL);
+    if (text != NULL) {
+        size_t text_len = 0;
+        for (int i = 0; text_len < 500 * 1024; i++) {
+            text_len += (size_t)snprintf(text + text_len, 64, "line %d %s\n", i, i % 7 == 0 ? "needle" : "hay");
+        }
+        len = gzip_member(buf, sizeof(buf), text);
+        free(text);
+        CHECK(len > 0);
+        write_fixture("truncated.gz", buf, len / 2);
+        CHECK(scan("truncated.gz", &total, results, sizeof(results)) == ERROR_FREAD);
+    }
+
+    // only the gzip magic isn't enough to be decompressed
+    write_text("magic.txt", "\x1f\x8bnot gzip needle\n");
+    CHECK(scan("magic.txt", &total, results, sizeof(results)) == 0);
+    CHECK(total == 1);
+}
+#endif
+
+static int compare_strings(
+    const void* a,
+    const void* b
+) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+static void test_ignore_rules(void) {
+    static const char* expected[] = {
+        ".gitignore",
+        "deep/foo/baz",
+        "keep.log",
+        "other/sub/nested.txt",
+        "plain.txt",
+        "sub/.ignore",
+        "sub/a.log",
+        "sub/build",
+        "sub/top.txt",
+    };
+    size_t expected_len = sizeof(expected) / sizeof(expected[0]);
+    char dir[CORE_PATH_MAX];
+    char* found[32];
+    size_t found_len = 0;
+
+    make_dir("ign");
+    make_dir("ign/sub");
+    make_dir("ign/sub/gen");
+    make_dir("ign/build");
+    make_dir("ign/other");
+    make_dir("ign/other/sub");
+    make_dir("ign/deep");
+    make_dir("ign/deep/x");
+    make_dir("ign/deep/x/foo");
+    make_dir("ign/deep/foo");
+    make_dir("ign/foo");
+    write_text("ign/.gitignore",
+        "# comment\n"
+        "*.log\n"
+        "!keep.log\n"
+        "/top.txt\n"
+        "build/\n"
+        "**/gen\n"
+        "sub/nested.txt\n"
+        "**/foo/bar\n");
+    write_text("ign/sub/.ignore", "!a.log\n");
+    write_text("ign/a.log", "");
+    write_text("ign/keep.log", "");
+    write_text("ign/top.txt", "");
+    write_text("ign/plain.txt", "");
+    write_text("ign/build/x.txt", "");
+    write_text("ign/sub/a.log", "");
+    write_text("ign/sub/b.log", "");
+    write_text("ign/sub/top.txt", "");
+    write_text("ign/sub/build", "");
+    write_text("ign/sub/nested.txt", "");
+    write_text("ign/sub/gen/y.txt", "");
+    write_text("ign/other/sub/nested.txt", "");
+    write_text("ign/foo/bar", "");
+    write_text("ign/deep/foo/bar", "");
+    write_text("ign/deep/foo/baz", "");
+    write_text("ign/deep/x/foo/bar", "");
+
+    struct search_query query = { .pattern = "needle", .use_ignore = 1 };
+    pthread_mutex_init(&query.status_lock, NULL);
+    CHECK(search_queue_init(&query.queue, 32) == 0);
+
+    make_path(dir, "ign");
+    CHECK(search_directory(&query, dir) == 0);
+    CHECK(query.status == 0);
+    search_queue_close(&query.queue);
+
+    char* file;
+    while ((file = search_queue_pop(&query.queue)) != NULL) {
+        if (found_len < sizeof(found) / sizeof(found[0])) found[found_len++] = file;
+        else free(file);
+    }
+    qsort(found, found_len, sizeof(found[0]), compare_strings);
+
+    // every path starts with dir, so sorting them sorts the relative names too
+    CHECK(found_len == expected_len);
+    for (size_t i = 0; i < found_len && i < expected_len; i++) {
+        const char* rel = found[i] + strlen(dir) + 1;
+        if (strcmp(rel, expected[i]) != 0) {
+            fprintf(stderr, "ignore: expected %s, found %s\n", expected[i], rel);
+            failures++;
+        }
+    }
+
+    for (size_t i = 0; i < found_len; i++) free(found[i]);
+    search_queue_destroy(&query.queue);
+    search_ignore_free(&query);
+    pthread_mutex_destroy(&query.status_lock);
+}
+
+int main(void) {
+    const char* tmpdir = getenv("TMPDIR");
+    snprintf(root, sizeof(root), "%s/search_test.XXXXXX", tmpdir != NULL ? tmpdir : "/tmp");
+    if (mkdtemp(root) == NULL) {
+        perror("mkdtemp");
+        return 1;
+    }
+    core_set_progname("search_test");
+
+    test_final_line_without_newline();
+    test_line_longer_than_block();
+#ifdef SEARCH_HAVE_ZLIB
+    test_gzip();
+#endif
+    test_ignore_rules();
+
+    nftw(root, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
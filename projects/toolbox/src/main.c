@@ -0,0 +1,96 @@
+#include "toolbox.h"
+
+#include "search.h"
+#include "explore.h"
+#include "list.h"
+#include "write.h"
+
+static const struct core_tool tool = {
+    .name = "toolbox",
+    .version = CORE_VERSION,
+    .usage =
+        "usage: toolbox COMMAND [ARG]...\n"
+        "       toolbox --serve SOCKET\n"
+        "       toolbox --connect SOCKET COMMAND [ARG]...\n"
+        "\nRun one of the bundled tools, either in-process or through a toolbox server.\n"
+        "The binary can also be invoked through a link named after a command.\n"
+        "\nOptions:\n"
+        "    -s SOCKET, --serve SOCKET    : listen on a Unix socket and run requests, keeping\n"
+        "                                   directory listings warm between them\n"
+        "    -c SOCKET, --connect SOCKET  : run COMMAND on the server listening on SOCKET\n"
+        "    -h, --help                   : show this message and exit\n"
+        "    -V, --version                : show the program version and exit\n"
+        "\nCommands:\n"
+        "    search, explore, list, write\n"
+        "\nCopyright (c) 2026 Addison Kline (GitHub: @addisonkline)\n",
+};
+
+static const struct toolbox_command commands[] = {
+    { "search",  search_main  },
+    { "explore", explore_main },
+    { "list",    list_main    },
+    { "write",   write_main   },
+};
+
+const struct toolbox_command* toolbox_find(
+    const char* name
+) {
+    const char* slash = strrchr(name, '/');
+    if (slash != NULL) name = slash + 1;
+
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        if (strcmp(commands[i].name, name) == 0) return &commands[i];
+    }
+    return NULL;
+}
+
+int toolbox_dispatch(
+    int argc,
+    char* argv[]
+) {
+    const struct toolbox_command* command = toolbox_find(argv[0]);
+    if (command == NULL) {
+        core_set_progname(tool.name);
+        return core_error(ERROR_INVALID_OPTION, "unknown command %s", argv[0]);
+    }
+
+    return command->main(argc, argv);
+}
+
+int main(int argc, char* argv[]) {
+    char* socket_path = NULL;
+
+    // multi-call: a link named after a command runs it directly
+    if (toolbox_find(argv[0]) != NULL) return toolbox_dispatch(argc, argv);
+
+    core_tool_init(&tool);
+
+    static struct option long_options[] = {
+        { "serve",   required_argument, 0, 's' },
+        { "connect", required_argument, 0, 'c' },
+        { "help",    no_argument,       0, 'h' },
+        { "version", no_argument,       0, 'V' },
+        { 0,         0,                 0,  0  }
+    };
+
+    // '+' stops at the command so its own options are left for it
+    int opt;
+    while ((opt = getopt_long(argc, argv, "+s:c:hV", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 's':
+                return core_finish(toolbox_serve(optarg));
+            case 'c':
+                socket_path = optarg;
+                break;
+            default:
+                return core_finish(core_args_default(&tool, opt));
+        }
+    }
+
+    if (core_args_require(argc, "command") != 0) return core_finish(ERROR_MISSING_ARGUMENT);
+
+    if (socket_path != NULL) {
+        return core_finish(toolbox_connect(socket_path, argc - optind, argv + optind));
+    }
+    return toolbox_dispatch(argc - optind, argv + optind);
+}
@@ -0,0 +1,323 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "toolbox.h"
+
+#define REQUEST_FDS 3
+
+// waits until fd is readable or the deadline (core_now_ms, -1 for none) passes
+static int wait_readable(
+    int fd,
+    double deadline
+) {
+    if (deadline < 0) return 0;
+
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    for (;;) {
+        double left = deadline - core_now_ms();
+        if (left <= 0) {
+            errno = ETIMEDOUT;
+            return -1;
+        }
+        // round up so a sub-millisecond remainder doesn't spin
+        int ret = poll(&pfd, 1, (int)left + 1);
+        if (ret > 0) return 0;
+        if (ret < 0 && errno != EINTR) return -1;
+    }
+}
+
+static int read_all(
+    int fd,
+    void* data,
+    size_t len,
+    double deadline
+) {
+    char* p = data;
+    while (len > 0) {
+        if (wait_readable(fd, deadline) == -1) return -1;
+        ssize_t ret = read(fd, p, len);
+        if (ret < 0 && errno == EINTR) continue;
+        if (ret <= 0) return -1;
+        p += ret;
+        len -= (size_t)ret;
+    }
+    return 0;
+}
+
+static int socket_address(
+    struct sockaddr_un* addr,
+    const char* socket_path
+) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr->sun_path)) {
+        return core_error(ERROR_PATH_TOO_LONG, "socket path too long: %s", socket_path);
+    }
+    strcpy(addr->sun_path, socket_path);
+    return 0;
+}
+
+// every cached directory pins an fd, so size the cache from the fd limit
+static size_t cache_capacity(void) {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == -1) return 0;
+
+    if (rl.rlim_max == RLIM_INFINITY || rl.rlim_max > TOOLBOX_CACHE_MAX_DIRS + TOOLBOX_FD_RESERVE) {
+        rl.rlim_max = TOOLBOX_CACHE_MAX_DIRS + TOOLBOX_FD_RESERVE;
+    }
+    if (rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+        getrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    if (rl.rlim_cur <= TOOLBOX_FD_RESERVE) return 0;
+    rl.rlim_cur -= TOOLBOX_FD_RESERVE;
+    return rl.rlim_cur > TOOLBOX_CACHE_MAX_DIRS ? TOOLBOX_CACHE_MAX_DIRS : (size_t)rl.rlim_cur;
+}
+
+static int receive_request(
+    int conn,
+    struct toolbox_request* req,
+    int fds[REQUEST_FDS],
+    double deadline
+) {
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * REQUEST_FDS)];
+        struct cmsghdr align;
+    } control;
+    struct iovec iov = { .iov_base = req, .iov_len = sizeof(*req) };
+    struct msghdr msg = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = control.buf,
+        .msg_controllen = sizeof(control.buf),
+    };
+
+    ssize_t ret;
+    do {
+        if (wait_readable(conn, deadline) == -1) return -1;
+        ret = recvmsg(conn, &msg, MSG_CMSG_CLOEXEC);
+    } while (ret < 0 && errno == EINTR);
+    if (ret <= 0) return -1;
+
+    int received = 0;
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+        size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count; i++) {
+            int fd;
+            memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(fd));
+            if (received < REQUEST_FDS) fds[received++] = fd;
+            else close(fd);
+        }
+    }
+    if (received != REQUEST_FDS || (msg.msg_flags & MSG_CTRUNC)) return -1;
+
+    // the header may have arrived split from the ancillary data
+    if ((size_t)ret < sizeof(*req)) {
+        if (read_all(conn, (char*)req + ret, sizeof(*req) - (size_t)ret, deadline) == -1) return -1;
+    }
+    return 0;
+}
+
+static int handle_client(
+    int conn,
+    int saved_fds[REQUEST_FDS]
+) {
+    struct toolbox_request req;
+    int fds[REQUEST_FDS] = { -1, -1, -1 };
+    char* data = NULL;
+    char** argv = NULL;
+    int status = -1;
+
+    // the whole request must arrive in time; one idle client would otherwise stall every other
+    double deadline = core_now_ms() + TOOLBOX_REQUEST_TIMEOUT_MS;
+    if (receive_request(conn, &req, fds, deadline) == -1) goto done;
+    if (req.argc == 0 || req.argc > TOOLBOX_MAX_ARGS || req.len == 0 || req.len > TOOLBOX_MAX_ARG_BYTES) goto done;
+
+    data = malloc(req.len);
+    argv = malloc(sizeof(*argv) * (req.argc + 1));
+    if (data == NULL || argv == NULL) goto done;
+    if (read_all(conn, data, req.len, deadline) == -1 || data[req.len - 1] != '\0') goto done;
+
+    // split the NUL-separated payload; the count must match exactly
+    uint32_t argc = 0;
+    for (size_t off = 0; off < req.len; off += strlen(data + off) + 1) {
+        if (argc == req.argc) goto done;
+        argv[argc++] = data + off;
+    }
+    if (argc != req.argc) goto done;
+    argv[argc] = NULL;
+
+    // run in the client's cwd with its stdout/stderr as ours
+    if (fchdir(fds[0]) == -1) goto done;
+    dup2(fds[1], STDOUT_FILENO);
+    dup2(fds[2], STDERR_FILENO);
+
+    status = toolbox_dispatch((int)argc, argv);
+
+    dup2(saved_fds[1], STDOUT_FILENO);
+    dup2(saved_fds[2], STDERR_FILENO);
+    fchdir(saved_fds[0]);
+    // the tool set its own name for messages; the server's are its own again
+    core_set_progname("toolbox");
+
+done:
+    for (int i = 0; i < REQUEST_FDS; i++) {
+        if (fds[i] != -1) close(fds[i]);
+    }
+    free(argv);
+    free(data);
+
+    if (status == -1) return core_error(ERROR_GENERIC, "dropped incomplete or malformed request");
+
+    int32_t reply = status;
+    core_write_all(conn, &reply, sizeof(reply));
+    return 0;
+}
+
+int toolbox_serve(
+    const char* socket_path
+) {
+    struct sockaddr_un addr;
+    struct stat st;
+
+    if (socket_address(&addr, socket_path) != 0) return ERROR_PATH_TOO_LONG;
+
+    // a vanished client must not take the server down with it
+    signal(SIGPIPE, SIG_IGN);
+    core_dir_cache_enable(cache_capacity());
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock == -1) return core_error(ERROR_GENERIC, "socket: %s", strerror(errno));
+
+    // replace a stale socket from a previous server, but nothing else
+    if (lstat(socket_path, &st) == 0 && S_ISSOCK(st.st_mode)) unlink(socket_path);
+
+    // requests run with the server's identity, so only its owner may connect
+    mode_t mask = umask(0077);
+    int bound = bind(sock, (struct sockaddr*)&addr, sizeof(addr));
+    umask(mask);
+
+    if (bound == -1 || chmod(socket_path, 0600) == -1 || listen(sock, SOMAXCONN) == -1) {
+        int ret = core_error(ERROR_GENERIC, "unable to listen on %s: %s", socket_path, strerror(errno));
+        close(sock);
+        return ret;
+    }
+
+    int saved_fds[REQUEST_FDS];
+    saved_fds[0] = open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    saved_fds[1] = fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 0);
+    saved_fds[2] = fcntl(STDERR_FILENO, F_DUPFD_CLOEXEC, 0);
+    if (saved_fds[0] == -1 || saved_fds[1] == -1 || saved_fds[2] == -1) {
+        close(sock);
+        return core_error(ERROR_GENERIC, "unable to save process state: %s", strerror(errno));
+    }
+
+    // requests run one at a time so tools never share stdout or the cache
+    for (;;) {
+        int conn = accept4(sock, NULL, NULL, SOCK_CLOEXEC);
+        if (conn == -1) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            core_error(ERROR_GENERIC, "accept: %s", strerror(errno));
+            break;
+        }
+
+        struct ucred cred = { .pid = 0, .uid = (uid_t)-1, .gid = (gid_t)-1 };
+        socklen_t cred_len = sizeof(cred);
+        if (getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) == -1 || cred.uid != geteuid()) {
+            core_error(ERROR_GENERIC, "rejected connection from uid %d", (int)cred.uid);
+            close(conn);
+            continue;
+        }
+
+        handle_client(conn, saved_fds);
+        close(conn);
+    }
+
+    for (int i = 0; i < REQUEST_FDS; i++) close(saved_fds[i]);
+    close(sock);
+    return ERROR_GENERIC;
+}
+
+int toolbox_connect(
+    const char* socket_path,
+    int argc,
+    char* argv[]
+) {
+    struct sockaddr_un addr;
+    struct toolbox_request req = { .argc = (uint32_t)argc, .len = 0 };
+
+    if (socket_address(&addr, socket_path) != 0) return ERROR_PATH_TOO_LONG;
+    if (argc > TOOLBOX_MAX_ARGS) return core_error(ERROR_INVALID_OPTION, "too many arguments");
+
+    size_t len = 0;
+    for (int i = 0; i < argc; i++) len += strlen(argv[i]) + 1;
+    if (len > TOOLBOX_MAX_ARG_BYTES) return core_error(ERROR_INVALID_OPTION, "arguments too long");
+    req.len = (uint32_t)len;
+
+    char* data = malloc(len);
+    if (data == NULL) return core_error(ERROR_MALLOC, "malloc failed");
+    char* p = data;
+    for (int i = 0; i < argc; i++) {
+        size_t arg_len = strlen(argv[i]) + 1;
+        memcpy(p, argv[i], arg_len);
+        p += arg_len;
+    }
+
+    int status = ERROR_GENERIC;
+    int cwd = open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (cwd == -1 || sock == -1 || connect(sock, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+        core_error(ERROR_GENERIC, "unable to connect to %s: %s", socket_path, strerror(errno));
+        goto done;
+    }
+
+    int fds[REQUEST_FDS] = { cwd, STDOUT_FILENO, STDERR_FILENO };
+    union {
+        char buf[CMSG_SPACE(sizeof(fds))];
+        struct cmsghdr align;
+    } control;
+    struct iovec iov = { .iov_base = &req, .iov_len = sizeof(req) };
+    struct msghdr msg = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = control.buf,
+        .msg_controllen = sizeof(control.buf),
+    };
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(sock, &msg, 0);
+    } while (sent < 0 && errno == EINTR);
+
+    int32_t reply;
+    if (sent < 0
+        || core_write_all(sock, (char*)&req + sent, sizeof(req) - (size_t)sent) == -1
+        || core_write_all(sock, data, len) == -1
+        || read_all(sock, &reply, sizeof(reply), -1) == -1) {
+        core_error(ERROR_GENERIC, "request to %s failed", socket_path);
+        goto done;
+    }
+    status = reply;
+
+done:
+    if (sock != -1) close(sock);
+    if (cwd != -1) close(cwd);
+    free(data);
+    return status;
+}
@@ -0,0 +1,36 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <string.h>
+
+#include "core.h"
+
+#define TOOLBOX_MAX_ARGS 4096
+#define TOOLBOX_MAX_ARG_BYTES (256 * 1024)
+#define TOOLBOX_CACHE_MAX_DIRS 65536
+#define TOOLBOX_FD_RESERVE 256
+#define TOOLBOX_REQUEST_TIMEOUT_MS 2000
+
+// request header sent by the client; followed by len bytes of NUL-terminated
+// arguments and accompanied (SCM_RIGHTS) by the client's cwd, stdout and stderr
+struct toolbox_request {
+    uint32_t argc;
+    uint32_t len;
+};
+
+struct toolbox_command {
+    const char* name;
+    int (*main)(int, char**);
+};
+
+const struct toolbox_command* toolbox_find(const char*);
+
+int toolbox_dispatch(int, char**);
+
+int toolbox_serve(const char*);
+
+int toolbox_connect(const char*, int, char**);
+
+int main(int, char**);
@@ -0,0 +1,228 @@
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <ftw.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "core.h"
+
+#define MAX_OUTPUT (64 * 1024)
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+static char root[CORE_PATH_MAX];
+static struct sockaddr_un server_addr = { .sun_family = AF_UNIX };
+static char* socket_path = server_addr.sun_path;
+
+static void make_path(
+    char* path,
+    const char* rel
+) {
+    CHECK(core_path_join(path, CORE_PATH_MAX, root, rel) == 0);
+}
+
+static void write_text(
+    const char* rel,
+    const char* text
+) {
+    char path[CORE_PATH_MAX];
+    make_path(path, rel);
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    CHECK(fd != -1);
+    if (fd == -1) return;
+    CHECK(core_write_all(fd, text, strlen(text)) == 0);
+    close(fd);
+}
+
+static void read_text(
+    const char* rel,
+    char* buf,
+    size_t size
+) {
+    char path[CORE_PATH_MAX];
+    make_path(path, rel);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    ssize_t nread = fd == -1 ? -1 : read(fd, buf, size - 1);
+    buf[nread > 0 ? nread : 0] = '\0';
+    if (fd != -1) close(fd);
+}
+
+static int remove_entry(
+    const char* path,
+    const struct stat* st,
+    int type,
+    struct FTW* ftw
+) {
+    (void)st;
+    (void)type;
+    (void)ftw;
+    return remove(path) == -1 ? -1 : 0;
+}
+
+// runs argv with stdout and stderr in files under root; returns its exit status
+static int run(
+    char* argv[],
+    const char* out_rel,
+    const char* err_rel
+) {
+    char out_path[CORE_PATH_MAX];
+    char err_path[CORE_PATH_MAX];
+    make_path(out_path, out_rel);
+    make_path(err_path, err_rel);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int out = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open(err_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out == -1 || err == -1) _exit(127);
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    int status;
+    if (pid == -1 || waitpid(pid, &status, 0) == -1) return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+static int wait_for_server(void) {
+    for (int i = 0; i < 200; i++) {
+        int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int ret = connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr));
+        close(sock);
+        if (ret == 0) return 0;
+        nanosleep(&(struct timespec){ .tv_nsec = 10 * 1000 * 1000 }, NULL);
+    }
+    return -1;
+}
+
+// the same command run in-process and through the server must agree
+static void check_round_trip(
+    int argc,
+    char* args[]
+) {
+    char* direct[16] = { TOOLBOX_BIN };
+    char* served[16] = { TOOLBOX_BIN, "--connect", socket_path };
+    static char direct_out[MAX_OUTPUT], served_out[MAX_OUTPUT];
+    static char direct_err[MAX_OUTPUT], served_err[MAX_OUTPUT];
+
+    for (int i = 0; i < argc; i++) {
+        direct[1 + i] = args[i];
+        served[3 + i] = args[i];
+    }
+
+    int direct_status = run(direct, "direct.out", "direct.err");
+    int served_status = run(served, "served.out", "served.err");
+    read_text("direct.out", direct_out, sizeof(direct_out));
+    read_text("served.out", served_out, sizeof(served_out));
+    read_text("direct.err", direct_err, sizeof(direct_err));
+    read_text("served.err", served_err, sizeof(served_err));
+
+    if (direct_status != served_status || strcmp(direct_out, served_out) != 0 || strcmp(direct_err, served_err) != 0) {
+        fprintf(stderr, "round trip of %s differs: status %d vs %d\n--- direct\n%s%s--- served\n%s%s",
+            args[0], direct_status, served_status, direct_out, direct_err, served_out, served_err);
+        failures++;
+    }
+}
+
+// a request that never completes must be dropped under the server's own name
+static void check_malformed_request(void) {
+    static char log[MAX_OUTPUT];
+
+    // wait_for_server's probes were dropped too; only look past them
+    read_text("server.err", log, sizeof(log));
+    size_t seen = strlen(log);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    CHECK(connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr)) == 0);
+    CHECK(core_write_all(sock, "bad", 3) == 0);
+    close(sock);
+
+    for (int i = 0; i < 300 && strstr(log + seen, "dropped") == NULL; i++) {
+        nanosleep(&(struct timespec){ .tv_nsec = 10 * 1000 * 1000 }, NULL);
+        read_text("server.err", log, sizeof(log));
+    }
+    CHECK(strstr(log + seen, "toolbox: dropped") != NULL);
+}
+
+int main(void) {
+    const char* tmpdir = getenv("TMPDIR");
+    snprintf(root, sizeof(root), "%s/toolbox_test.XXXXXX", tmpdir != NULL ? tmpdir : "/tmp");
+    if (mkdtemp(root) == NULL) {
+        perror("mkdtemp");
+        return 1;
+    }
+    char sock[CORE_PATH_MAX];
+    make_path(sock, "toolbox.sock");
+    if (strlen(sock) >= sizeof(server_addr.sun_path)) {
+        fprintf(stderr, "socket path too long: %s\n", sock);
+        return 1;
+    }
+    memcpy(socket_path, sock, strlen(sock) + 1);
+
+    char tree[CORE_PATH_MAX];
+    make_path(tree, "tree");
+    CHECK(mkdir(tree, 0755) == 0);
+    write_text("tree/a.txt", "a needle\nhay\n");
+    write_text("tree/b.txt", "hay\nneedle needle\n");
+
+    char* serve[] = { TOOLBOX_BIN, "--serve", socket_path, NULL };
+    char server_err[CORE_PATH_MAX];
+    make_path(server_err, "server.err");
+    pid_t server = fork();
+    if (server == 0) {
+        int err = open(server_err, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (err != -1) dup2(err, STDERR_FILENO);
+        execv(serve[0], serve);
+        _exit(127);
+    }
+    CHECK(server != -1);
+
+    if (server != -1 && wait_for_server() == 0) {
+        // relative paths resolve against the client's cwd, not the server's
+        CHECK(chdir(root) == 0);
+
+        char* search[] = { "search", "-n", "needle", "tree/a.txt", "tree/b.txt" };
+        char* list[] = { "list", "tree" };
+        char* missing[] = { "list", "missing" };
+        check_round_trip(5, search);
+        check_round_trip(2, list);
+        check_round_trip(2, missing);
+
+        check_malformed_request();
+    } else {
+        fprintf(stderr, "server did not come up\n");
+        failures++;
+    }
+
+    if (server > 0) {
+        kill(server, SIGTERM);
+        waitpid(server, NULL, 0);
+    }
+    nftw(root, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
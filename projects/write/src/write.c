@@ -0,0 +1,65 @@
+#include "write.h"
+
+static const struct core_tool tool = {
+    .name = "write",
+    .version = CORE_VERSION,
+    .usage =
+        "usage: write [OPTION]... CONTENT FILE...\n"
+        "\nWrite the given content to file(s)\n"
+        "\nOptions:\n"
+        "    -h, --help: show this message and exit\n"
+        "    -V, --version: show the program version and exit\n"
+        "\nPositionals:\n"
+        "    CONTENT: the content to write to the file(s)\n"
+        "    FILE...: the file(s) to write the content to\n"
+        "\nCopyright (c) 2026 Addison Kline (GitHub: @addisonkline)\n",
+};
+
+int write_file(
+    const char* content,
+    const char* file
+) {
+    struct core_out out;
+    if (core_out_open(&out, file, 0) != 0) return ERROR_FILE_OPEN;
+
+    core_out_str(&out, content);
+
+    if (core_out_close(&out) != 0) {
+        return core_error(ERROR_FWRITE, "failed to write file %s", file);
+    }
+
+    return 0;
+}
+
+int write_main(int argc, char* argv[]) {
+    char* content;
+
+    core_tool_init(&tool);
+
+    static struct option long_options[] = {
+        { "help",    no_argument, 0, 'h' },
+        { "version", no_argument, 0, 'V' },
+        { 0,         0,           0,  0  }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "hV", long_options, NULL)) != -1) {
+        return core_finish(core_args_default(&tool, opt));
+    }
+
+    // extract content
+    if (core_args_require(argc, "content") != 0) return core_finish(ERROR_MISSING_ARGUMENT);
+    content = argv[optind];
+    optind++;
+
+    // extract file(s)
+    if (core_args_require(argc, "file(s)") != 0) return core_finish(ERROR_MISSING_ARGUMENT);
+
+    int status = 0;
+    for (int i = optind; i < argc; i++) {
+        int ret = write_file(content, argv[i]);
+        if (ret != 0) status = ret;
+    }
+
+    return core_finish(status);
+}